@@ -0,0 +1,78 @@
+#!/bin/sh
+# Cache des tables de la carte (--cache) : les parties doivent être les mêmes sans cache,
+# avec un cache vide puis avec le cache rempli ; un fichier déjà valide n'est pas réécrit,
+# un fichier d'une autre version ou tronqué est ignoré puis remplacé.
+# Usage : sh tests/cache.sh (depuis Version4)
+
+set -u
+repertoire=$(mktemp -d)
+trap 'rm -rf "$repertoire"' EXIT
+programme="$repertoire/version4"
+cache="$repertoire/cache"
+echec=0
+
+gcc -std=gnu99 -O2 -Wall -Wextra -o "$programme" version4.c -lpthread -lm || exit 1
+mkdir "$cache"
+
+# résultats d'un tournoi de la stratégie hamilton, qui met le cycle de chaque carte en cache,
+# sans les durées (la table des distances ne sert qu'à mcts et alphabeta, limitées en temps)
+resultats() {
+	timeout 300 "$programme" --tournoi 10 1 --plateau 120 60 --strategie1 hamilton --strategie2 heuristique "$@" 2>&1 |
+		grep -v '^Durée'
+}
+
+# numéro d'i-nœud de chaque fichier du cache : il change quand le fichier est réécrit
+inoeuds() {
+	ls -i "$cache" | sort -k 2
+}
+
+# champ version de l'en-tête (après les 8 octets de la signature)
+version() {
+	od -A n -t d4 -j 8 -N 4 "$1" | tr -d ' '
+}
+
+resultats > "$repertoire/reference.txt"
+
+resultats --cache "$cache" > "$repertoire/vide.txt"
+if ! cmp -s "$repertoire/reference.txt" "$repertoire/vide.txt"; then
+	echo "échec : résultats différents avec un cache vide"
+	echec=1
+fi
+if [ -z "$(ls "$cache")" ]; then
+	echo "échec : aucun fichier écrit dans le cache"
+	exit 1
+fi
+
+inoeuds > "$repertoire/avant.txt"
+resultats --cache "$cache" > "$repertoire/rempli.txt"
+inoeuds > "$repertoire/apres.txt"
+if ! cmp -s "$repertoire/reference.txt" "$repertoire/rempli.txt"; then
+	echo "échec : résultats différents avec le cache rempli"
+	echec=1
+fi
+if ! cmp -s "$repertoire/avant.txt" "$repertoire/apres.txt"; then
+	echo "échec : des fichiers valides du cache ont été réécrits"
+	echec=1
+fi
+
+# en-têtes d'une autre version et un fichier tronqué : à ignorer et remplacer
+premier=""
+for fichier in "$cache"/*.bin; do
+	[ -z "$premier" ] && premier="$fichier" && attendue=$(version "$fichier")
+	printf '\377\377\377\377' | dd of="$fichier" bs=1 seek=8 conv=notrunc 2> /dev/null
+done
+dernier="$fichier"
+head -c 100 "$dernier" > "$repertoire/tronque.bin"
+mv "$repertoire/tronque.bin" "$dernier"
+resultats --cache "$cache" > "$repertoire/invalide.txt"
+if ! cmp -s "$repertoire/reference.txt" "$repertoire/invalide.txt"; then
+	echo "échec : résultats différents avec un cache invalide"
+	echec=1
+fi
+if [ "$(version "$premier")" != "$attendue" ] || [ "$(wc -c < "$dernier")" -le 100 ]; then
+	echo "échec : les fichiers invalides du cache n'ont pas été remplacés"
+	echec=1
+fi
+
+[ "$echec" -eq 0 ] && echo "cache : ok"
+exit "$echec"
@@ -0,0 +1,37 @@
+#!/bin/sh
+# Choix des directions en parallèle : avec plusieurs serpents, les parties doivent être
+# identiques quel que soit le nombre de planificateurs (--planificateurs 1 ou 4), pour les
+# stratégies qui ne dépendent pas d'un budget de temps (mcts et alphabeta en dépendent).
+# Usage : sh tests/determinisme.sh (depuis Version4)
+
+set -u
+repertoire=$(mktemp -d)
+trap 'rm -rf "$repertoire"' EXIT
+programme="$repertoire/version4"
+echec=0
+
+gcc -std=gnu99 -O2 -Wall -Wextra -o "$programme" version4.c -lpthread -lm || exit 1
+
+# résultats d'un lancement, sans les durées mesurées
+resultats() {
+	timeout 300 "$programme" "$@" 2>&1 | grep -v '^Durée' | sed 's/ en [0-9.]* s : .*//'
+}
+
+for strategies in "dstar heuristique" "astar hamilton" "champ heuristique"; do
+	set -- $strategies
+	for mode in "--tournoi 40 2" "--simulation 10"; do
+		# le mode est découpé en mots exprès (option et nombres de parties et de threads)
+		resultats $mode --serpents 6 --croissance 3 --planificateurs 1 \
+			--strategie1 "$1" --strategie2 "$2" > "$repertoire/un.txt"
+		resultats $mode --serpents 6 --croissance 3 --planificateurs 4 \
+			--strategie1 "$1" --strategie2 "$2" > "$repertoire/quatre.txt"
+		if [ ! -s "$repertoire/un.txt" ] || ! cmp -s "$repertoire/un.txt" "$repertoire/quatre.txt"; then
+			echo "échec : $mode, $1 contre $2 : résultats différents avec 1 et 4 planificateurs"
+			diff "$repertoire/un.txt" "$repertoire/quatre.txt"
+			echec=1
+		fi
+	done
+done
+
+[ "$echec" -eq 0 ] && echo "déterminisme : ok"
+exit "$echec"
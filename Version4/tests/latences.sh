@@ -0,0 +1,53 @@
+#!/bin/sh
+# Histogrammes des latences (--latences) : pour chaque phase, les quantiles doivent être
+# croissants (p50 <= p99 <= p999 <= max), chaque tour doit être mesuré une fois, et le
+# fichier donné à --latences doit contenir le même tableau que la sortie.
+# Usage : sh tests/latences.sh (depuis Version4)
+
+set -u
+repertoire=$(mktemp -d)
+trap 'rm -rf "$repertoire"' EXIT
+programme="$repertoire/version4"
+echec=0
+
+gcc -std=gnu99 -O2 -Wall -Wextra -o "$programme" version4.c -lpthread -lm || exit 1
+
+if ! timeout 120 "$programme" --simulation 5 --serpents 4 --croissance 3 --strategie1 astar \
+	--latences "$repertoire/latences.txt" > "$repertoire/sortie.txt"; then
+	echo "échec : --simulation avec --latences"
+	exit 1
+fi
+
+# nombre de tours joués, lu sur la ligne "N parties, T tours en ..."
+tours=$(sed -n 's/^[0-9]* parties, \([0-9]*\) tours en .*/\1/p' "$repertoire/sortie.txt")
+if [ -z "$tours" ]; then
+	echo "échec : nombre de tours absent de la sortie"
+	exit 1
+fi
+
+# lignes des phases : nom (un ou plusieurs mots) puis p50, p99, p999, max et mesures
+erreurs=$(awk -v tours="$tours" '
+	/^Latences/ { entete = 1; next }
+	entete && NF >= 6 {
+		n = NF
+		phases++
+		if ($(n - 4) > $(n - 3) || $(n - 3) > $(n - 2) || $(n - 2) > $(n - 1))
+			print "quantiles non croissants : " $0
+		if ($n != tours)
+			print "mesures différentes des " tours " tours : " $0
+	}
+	END { if (phases == 0) print "aucune phase mesurée" }
+' "$repertoire/sortie.txt")
+if [ -n "$erreurs" ]; then
+	echo "échec : $erreurs"
+	echec=1
+fi
+
+if ! grep -q '^Latences' "$repertoire/latences.txt" ||
+	! sed -n '/^Latences/,$p' "$repertoire/sortie.txt" | cmp -s - "$repertoire/latences.txt"; then
+	echo "échec : le fichier des latences diffère du tableau affiché"
+	echec=1
+fi
+
+[ "$echec" -eq 0 ] && echo "latences : ok"
+exit "$echec"
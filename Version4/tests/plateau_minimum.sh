@@ -0,0 +1,34 @@
+#!/bin/sh
+# Plateau de taille minimale (30 x 15) : les parties aux pavés tirés au hasard doivent
+# se terminer, et une taille de pavés impossible à placer doit être refusée au lancement.
+# Usage : sh tests/plateau_minimum.sh (depuis Version4)
+
+set -u
+repertoire=$(mktemp -d)
+trap 'rm -rf "$repertoire"' EXIT
+programme="$repertoire/version4"
+echec=0
+
+gcc -std=gnu99 -O2 -Wall -Wextra -o "$programme" version4.c -lpthread -lm || exit 1
+
+# pavés de 2 cases : il existe des positions valides, les parties doivent aller au bout
+if ! timeout 60 "$programme" --simulation 20 --plateau 30 15 --paves 2 > /dev/null; then
+	echo "échec : --simulation sur un plateau de 30 x 15 avec des pavés de 2 cases"
+	echec=1
+fi
+if ! timeout 60 "$programme" --tournoi 20 2 --plateau 30 15 --paves 2 > /dev/null; then
+	echo "échec : --tournoi sur un plateau de 30 x 15 avec des pavés de 2 cases"
+	echec=1
+fi
+
+# pavés de 5 cases : aucune position valide, le programme doit s'arrêter en erreur
+# au lieu de chercher sans fin (timeout retourne 124 dans ce cas)
+timeout 10 "$programme" --simulation 2 --plateau 30 15 > /dev/null 2>&1
+code=$?
+if [ "$code" -eq 0 ] || [ "$code" -eq 124 ]; then
+	echo "échec : pavés de 5 cases sur un plateau de 30 x 15 (code de retour $code)"
+	echec=1
+fi
+
+[ "$echec" -eq 0 ] && echo "plateau minimum : ok"
+exit "$echec"
@@ -0,0 +1,40 @@
+#!/bin/sh
+# Plusieurs serpents et croissance : parties à 2 et à 8 serpents qui grandissent de plusieurs
+# anneaux par pomme, jouées par un programme compilé avec les sanitiseurs d'adresses et de
+# comportements indéfinis, arrêté à la première erreur. Les corps circulaires doivent grandir
+# jusqu'à leur capacité sans déborder, et les cases occupées par plusieurs serpents (têtes qui
+# se rencontrent, corps retirés après une collision) rester dans le plateau.
+# Usage : sh tests/serpents_croissance.sh (depuis Version4)
+
+set -u
+repertoire=$(mktemp -d)
+trap 'rm -rf "$repertoire"' EXIT
+programme="$repertoire/version4"
+echec=0
+
+if ! gcc -std=gnu99 -O1 -g -fsanitize=address,undefined -fno-sanitize-recover=all \
+	-o "$programme" version4.c -lpthread -lm 2> /dev/null; then
+	echo "serpents et croissance : sanitiseurs indisponibles, test ignoré"
+	exit 0
+fi
+
+# lancement qui doit aller au bout sans erreur des sanitiseurs
+lancer() {
+	if ! timeout 300 "$programme" "$@" > /dev/null 2> "$repertoire/erreurs.txt"; then
+		echo "échec : $*"
+		head -20 "$repertoire/erreurs.txt"
+		echec=1
+	fi
+}
+
+# deux serpents qui grandissent beaucoup : les anneaux ajoutés remplissent les tableaux circulaires
+lancer --simulation 5 --plateau 60 30 --paves 2 --croissance 30 --strategie1 astar --strategie2 dstar
+lancer --simulation 5 --plateau 60 30 --paves 2 --croissance 30 --strategie1 hamilton --strategie2 champ
+
+# huit serpents sur un petit plateau : collisions fréquentes, y compris tête contre tête
+lancer --tournoi 20 2 --plateau 40 20 --paves 2 --serpents 8 --croissance 5 --strategie1 hamilton --strategie2 heuristique
+lancer --tournoi 20 2 --plateau 40 20 --paves 2 --serpents 8 --croissance 5 --planificateurs 4 \
+	--strategie1 dstar --strategie2 astar
+
+[ "$echec" -eq 0 ] && echo "serpents et croissance : ok"
+exit "$echec"
@@ -21,6 +21,9 @@
 
 
 /* Fichiers inclus */
+// fonctions POSIX (clock_gettime, clock_nanosleep, mkstemp, fdopen) et PATH_MAX
+// déclarés aussi avec -std=c11
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
@@ -28,704 +31,5606 @@
 #include <termios.h>
 #include <fcntl.h>
 #include <time.h>
+#include <string.h>
+#include <pthread.h>
+#include <limits.h>
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <errno.h>
 
 
-// taille du serpent
+// taille du serpent au départ (et tout au long de la partie sans croissance)
 #define TAILLE 10
-// dimensions du plateau
+// mode croissance : nombre maximal d'anneaux ajoutés par pomme mangée
+#define CROISSANCE_MAX 10000
+// dimensions du plateau par défaut (modifiables au lancement, voir largeurPlateau)
 #define LARGEUR_PLATEAU 80	
 #define HAUTEUR_PLATEAU 40
+// dimensions extrêmes acceptées sur la ligne de commande
+#define LARGEUR_MIN 30
+#define HAUTEUR_MIN 15
+#define DIMENSION_MAX 10000
 // position initiale de la tête des serpent
-#define X_INITIAL 40
-#define Y_INITIAL_SERPENT_1 13
-#define Y_INITIAL_SERPENT_2 27
+#define X_INITIAL (largeurPlateau / 2)
+#define Y_INITIAL_SERPENT_1 (hauteurPlateau / 3)
+#define Y_INITIAL_SERPENT_2 (hauteurPlateau - hauteurPlateau / 3)
 // nombre de pommes à manger pour gagner
 #define NB_POMMES 10
-// caractéristiques constantes des pavés (nombre et taille)
+// caractéristiques des pavés (nombre et taille par défaut)
 #define NB_PAVES 6
 #define TAILLE_PAVES 5
 // temporisation entre deux déplacements des serpents, 200 000 microseconces
+// (version rapide à 20 000 : compiler avec -DATTENTE=20000 ou lancer avec "--vitesse 10")
+#ifndef ATTENTE
 #define ATTENTE 200000
+#endif
 // caractères pour représenter les serpents
 #define CORPS 'X'
 #define TETE_SERPENT_1 '1'
 #define TETE_SERPENT_2 '2'
+#define TETE_AUTRE_SERPENT 'O'
 // touches de direction ou d'arrêt du jeu
 #define HAUT 1
 #define BAS 2
 #define GAUCHE 3
 #define DROITE 4
-#define CHEMIN_POMME 5
 #define STOP 'a'
 // caractères pour les éléments du plateau
 #define BORDURE '#'
 #define VIDE ' '
 #define POMME '6'
-// coordonnées X et Y des issues
-#define ISSUE_HAUT_X 40
-#define ISSUE_HAUT_Y 0
-#define ISSUE_BAS_X 40
-#define ISSUE_BAS_Y 40
-#define ISSUE_GAUCHE_X 0
-#define ISSUE_GAUCHE_Y 20
-#define ISSUE_DROITE_X 80
-#define ISSUE_DROITE_Y 20
+// mode simulation : nombre de parties jouées par défaut
+// et nombre maximal de déplacements avant d'abandonner une partie qui tourne en rond
+#define NB_PARTIES_SIMULATION 1000
+#define LIMITE_DEPLACEMENTS 100000
+// mode tournoi : graine de la première partie (la partie i utilise GRAINE_TOURNOI + i)
+#define GRAINE_TOURNOI 1
+// tirages au hasard de la position d'un pavé avant de prendre la première position valide
+#define ESSAIS_PAVE 1000
+// nombre de serpents par défaut et nombre maximal accepté sur la ligne de commande
+#define NB_SERPENTS 2
+#define NB_SERPENTS_MAX 10000
+// nombre de serpents pris d'un coup par un thread de planification
+#define TRANCHE_PLANIFICATION 8
+// mode banc d'essai : durée minimale d'une mesure en secondes, et état "fin encombrée"
+// obtenu en jouant TOURS_BANC tours avec NB_SERPENTS_BANC serpents
+#define DUREE_MESURE_BANC 0.2
+#define NB_SERPENTS_BANC 40
+#define TOURS_BANC 150
+// états du plateau et fonctions mesurés par le banc d'essai
+#define ETAT_DEPART 0
+#define ETAT_ENCOMBRE 1
+#define ETAT_PAVES_ISSUES 2
+#define NB_ETATS_BANC 3
+#define BANC_DIRECTION_SERPENT 0
+#define BANC_VERIFIER_COLLISION 1
+#define BANC_ETAPE_HPA 2
+#define BANC_PROGRESSER 3
+#define BANC_DESSINER_PLATEAU 4
+#define NB_FONCTIONS_BANC 5
+// phases d'un tour dont la durée est mesurée : choix des directions, déplacements
+// (progresser, éliminations et pommes), écriture sur le terminal et retard au réveil
+// de l'attente du clavier sur l'échéance du tour
+#define PHASE_PLANIFICATION 0
+#define PHASE_MISE_A_JOUR 1
+#define PHASE_AFFICHAGE 2
+#define PHASE_CLAVIER 3
+#define NB_PHASES 4
+// histogrammes des durées : SOUS_SEAUX seaux par puissance de 2 de nanosecondes
+#define SOUS_SEAUX 8
+#define NB_SEAUX (62 * SOUS_SEAUX)
+// stratégies de choix de la direction des serpents
+#define STRATEGIE_HEURISTIQUE 0
+#define STRATEGIE_CHAMP 1
+#define STRATEGIE_ASTAR 2
+#define STRATEGIE_DSTAR 3
+#define STRATEGIE_HAMILTON 4
+#define STRATEGIE_MCTS 5
+#define STRATEGIE_ALPHABETA 6
+#define NB_STRATEGIES 7
+// distance d'une case depuis laquelle la pomme est inaccessible
+#define DISTANCE_INFINIE INT_MAX
+// stratégie hamilton : cases laissées libres entre la case visée par un raccourci et la queue,
+// cases du cycle examinées devant la tête à la recherche des corps des serpents (plus loin,
+// ils auront bougé avant que la tête n'y arrive), part du cycle que le corps doit dépasser
+// pour que le serpent le suive, et liens de l'arbre couvrant des blocs de 2 x 2 cases
+// vers leurs voisins
+#define MARGE_CYCLE 4
+#define PORTEE_CYCLE 4096
+#define PART_CYCLE 4
+#define LIEN_HAUT 1
+#define LIEN_BAS 2
+#define LIEN_GAUCHE 4
+#define LIEN_DROITE 8
+// table des distances entre cases libres : nombre maximal de cases libres de la carte
+// (au-delà, la table prendrait plus de 36 Mo) et distance entre cases qui ne communiquent pas
+#define NB_LIBRES_MAX_DISTANCES 6000
+#define DISTANCE_INCONNUE 0xffff
+// recherche hiérarchique de la stratégie heuristique : côté des grappes carrées du plateau
+// et longueur d'un passage entre deux grappes à partir de laquelle il a deux entrées
+#define TAILLE_GRAPPE 16
+#define ENTREE_LONGUE 6
+// fichiers du cache des tables de la carte : signature, version du format (à changer
+// avec le contenu ou l'ordre des tableaux) et contenus possibles
+#define MAGIE_CACHE "SNAKECAR"
+#define VERSION_CACHE 2
+#define CACHE_DISTANCES 0
+#define CACHE_CYCLE 1
+#define NB_CONTENUS_CACHE 2
+// taille totale au-delà de laquelle les fichiers du cache les moins récemment utilisés
+// sont supprimés avant d'en écrire un nouveau (en octets)
+#define TAILLE_MAX_CACHE ((long long)512 * 1024 * 1024)
+// stratégie mcts : durée de la recherche par tour par défaut (en millisecondes), nombre de tours
+// d'une simulation, noeuds de l'arbre de chaque thread, constante d'exploration C de UCT1
+// (gains entre 0 et 1), une direction sur ALEA_MCTS tirée au hasard par la politique des
+// simulations, et gain maximal d'une simulation où le serpent meurt (les autres gains vont
+// de GAIN_MORT_MCTS à 1)
+#define BUDGET_MCTS 10
+#define HORIZON_MCTS 40
+#define NB_NOEUDS_MCTS 65536
+#define EXPLORATION_MCTS 0.5
+#define ALEA_MCTS 4
+#define GAIN_MORT_MCTS 0.3
+// stratégie alphabeta : durée de la recherche par tour par défaut (en millisecondes), distance
+// (en cases, tête à tête) en deçà de laquelle un adversaire est affronté, profondeur maximale
+// en tours, nombre d'entrées de la table de transposition (puissance de 2), valeurs
+// d'une position (élimination, pomme d'avance, et borne des valeurs) et nombre de coups
+// du jeu fictif qui approche la valeur d'un tour sans point selle
+#define BUDGET_ALPHABETA 10
+#define RAYON_DUEL_AB 6
+#define PROFONDEUR_MAX_AB 24
+#define TAILLE_TABLE_AB (1 << 18)
+#define VALEUR_MORT_AB 30000
+#define POIDS_POMME_AB 1000
+#define VALEUR_INFINIE_AB 32000
+#define ITERATIONS_JEU_AB 64
+// morceaux de serpent distingués par les clés de Zobrist (les serpents qui ne sont pas
+// du duel ont le numéro SERPENTS_AUTRES_AB)
+#define ZOBRIST_CORPS 0
+#define ZOBRIST_TETE 1
+#define SERPENTS_AUTRES_AB 2
+
+// taille maximale de la partie du plateau affichée à l'écran (fenêtre qui suit le serpent 1)
+#define LARGEUR_VUE 80
+#define HAUTEUR_VUE 40
+// distance minimale entre la tête du serpent 1 et le bord de la fenêtre avant de la recentrer
+#define MARGE_VUE 5
+// taille du tampon d'un rafraîchissement de l'écran : au pire, un déplacement du curseur
+// ("\033[HH;LLf") suivi d'un caractère pour chaque case, plus le retour du curseur en (1, 1)
+#define TAILLE_TAMPON_ECRAN (LARGEUR_VUE * HAUTEUR_VUE * 12 + 16)
+// modes de lancement du programme
+#define MODE_JEU 0
+#define MODE_SIMULATION 1
+#define MODE_TOURNOI 2
+#define MODE_BANC 3
+// résultat d'une partie
+// (plus généralement, le vainqueur est désigné par son numéro de serpent, à partir de 1)
+#define EGALITE 0
+#define VICTOIRE_SERPENT_1 1
+#define VICTOIRE_SERPENT_2 2
 
 // définition des positions X et Y des pommes dans un tableau
 // et des positions des coins supérieurs gauches des pavés dans un tableau
-int lesPommesX[NB_POMMES] = {40, 75, 78, 2, 9, 78, 74, 2, 72, 5};
-int lesPommesY[NB_POMMES] = {20, 38, 2, 2, 5, 38, 32, 38, 32, 2};
-int lesPavesX[NB_PAVES] = { 4, 73, 4, 73, 38, 38};
-int lesPavesY[NB_PAVES] = { 4, 4, 33, 33, 14, 22};
+// (disposition par défaut, recopiée dans le contexte de chaque partie)
+const int POMMES_X[NB_POMMES] = {40, 75, 78, 2, 9, 78, 74, 2, 72, 5};
+const int POMMES_Y[NB_POMMES] = {20, 38, 2, 2, 5, 38, 32, 38, 32, 2};
+const int PAVES_X[NB_PAVES] = { 4, 73, 4, 73, 38, 38};
+const int PAVES_Y[NB_PAVES] = { 4, 4, 33, 33, 14, 22};
+
+// noms des stratégies sur la ligne de commande (indicés par STRATEGIE_*)
+const char *NOMS_STRATEGIES[NB_STRATEGIES] = {"heuristique", "champ", "astar", "dstar", "hamilton", "mcts", "alphabeta"};
+
+// préfixes des fichiers du cache (indicés par CACHE_*)
+const char *NOMS_CACHE[NB_CONTENUS_CACHE] = {"distances", "cycle"};
+
+// noms des phases d'un tour (indicés par PHASE_*)
+const char *NOMS_PHASES[NB_PHASES] = {"planification", "mise à jour", "affichage", "clavier"};
 
+// noms des états et des fonctions du banc d'essai (indicés par ETAT_* et BANC_*)
+const char *NOMS_ETATS_BANC[NB_ETATS_BANC] = {"départ", "fin encombrée", "pavés et issues"};
+const char *NOMS_FONCTIONS_BANC[NB_FONCTIONS_BANC] = {"directionSerpent", "verifierCollisionProchainDeplacement",
+                                                      "etapeHpa", "progresser", "dessinerPlateau"};
 
-// définition d'un type pour le plateau
-// Attention, pour que les indices du tableau 2D (qui commencent à 0) coincident
+// dimensions du plateau, colonne des issues du haut et du bas, ligne des issues de gauche
+// et de droite, et taille des pavés : réglées par la ligne de commande avant la première partie,
+// puis seulement lues (elles sont communes à toutes les parties et à tous les threads)
+int largeurPlateau = LARGEUR_PLATEAU;
+int hauteurPlateau = HAUTEUR_PLATEAU;
+int xIssues = LARGEUR_PLATEAU / 2;
+int yIssues = HAUTEUR_PLATEAU / 2;
+int taillePaves = TAILLE_PAVES;
+// répertoire du cache des tables de la carte (NULL : pas de cache), lui aussi réglé au lancement
+const char *repertoireCache = NULL;
+
+
+// Les tableaux d'une valeur par case du plateau sont alloués dynamiquement et rangés
+// ligne par ligne : la case (x, y) est à l'indice CASE(x, y).
+// Attention, pour que les indices du tableau (qui commencent à 0) coincident
 // avec les coordonées à l'écran (qui commencent à 1), on ajoute 1 aux dimensions
-// et on neutralise la ligne 0 et la colonne 0 du tableau 2D (elles ne sont jamais
-// utilisées)
-typedef char tPlateau[LARGEUR_PLATEAU + 1][HAUTEUR_PLATEAU + 1];
+// et on neutralise la ligne 0 et la colonne 0 (elles ne sont jamais utilisées)
+#define CASE(x, y) ((y) * (largeurPlateau + 1) + (x))
+#define CASE_X(c) ((c) % (largeurPlateau + 1))
+#define CASE_Y(c) ((c) / (largeurPlateau + 1))
+#define NB_CASES ((size_t)(largeurPlateau + 1) * (hauteurPlateau + 1))
 
-// déclaration des compteurs de pommes pour le serpent 1, pour le serpent 2
-int nbPommes1 = 0;
-int nbPommes2 = 0;
+// partie du plateau affichée, même convention d'indices mais ligne par ligne : [y][x]
+typedef char tVue[HAUTEUR_VUE + 1][LARGEUR_VUE + 1];
 
-// Total des déplacements des 2 serpents
-int deplacements1 = 0;
-int deplacements2 = 0;
+// plateau compressé à un bit par case, les cases (x, y) étant rangées ligne par ligne
+// au bit (y - 1) * largeurPlateau + (x - 1) ; les bits au-delà de la dernière case restent à 0
+#define NB_MOTS_BITBOARD (((size_t)largeurPlateau * hauteurPlateau + 63) / 64)
+typedef struct
+{
+	uint64_t *mots; // NB_MOTS_BITBOARD mots
+} tBitboard;
 
-/* Déclaration des fonctions et procédures*/
-// Fonctions plateau, pommes et pavés
-void initPlateau(tPlateau plateau, int lesX[], int lesY[]);
-void dessinerPlateau(tPlateau plateau);
-void ajouterPomme(tPlateau plateau, int iPomme);
-void placerPaves(tPlateau plateau);
-void afficher(int, int, char);
-void effacer(int x, int y);
-// Fonctions relatives au serpent 1
-void dessinerSerpent1(int lesX1[], int lesY1[]);
-void directionSerpent1(int lesX1[], int lesY1[], tPlateau plateau, char *direction1, int x, int y, int lesX2[], int lesY2[], char directionSerpent2);
-bool verifierCollisionProchainDeplacement1(int lesX1[], int lesY1[], tPlateau plateau, char prochaineDirection1, int lesX2[], int lesY2[], char directionSerpent2);
-int calculDistance1(int lesX1[], int lesY1[], int pommeX, int pommeY);
-void progresser1(int lesX1[], int lesY1[], char direction1, tPlateau plateau, bool *collision1, bool *pommeMangee1, bool *utiliserIssue1);
-// Fonctions relatives au serpent 2
-void dessinerSerpent2(int lesX2[], int lesY2[]);
-void directionSerpent2(int lesX2[], int lesY2[], tPlateau plateau, char *direction2, int objectifX, int objectifY, int lesX1[], int lesY1[], char directionSerpent2);
-bool verifierCollisionProchainDeplacement2(int lesX2[], int lesY2[], tPlateau plateau, char prochaineDirection2, int lesX1[], int lesY1[], char directionSerpent1);
-int calculDistance2(int lesX2[], int lesY2[], int pommeX, int pommeY);
-void progresser2(int lesX2[], int lesY2[], char direction2, tPlateau plateau, bool *collision2, bool *pommeMangee2, bool *utiliserIssue2);
-// Fonctions boites noires
-void gotoxy(int x, int y);
-int kbhit();
-void disable_echo();
-void enable_echo();
+// noeud en attente dans le tas (file de priorité) de l'algorithme A*
+typedef struct
+{
+	int f; // coût estimé du chemin passant par la case : g + heuristique
+	int g; // nombre de déplacements depuis la tête
+	short x;
+	short y;
+} tNoeud;
 
-// Main du programme
-int main()
+// réserve de mémoire de l'algorithme A*, réutilisée d'une recherche à l'autre :
+// une case n'appartient à la recherche en cours que si sa marque vaut numeroRecherche,
+// ce qui évite de tout remettre à zéro avant chaque recherche
+// (tableaux d'une valeur par case, alloués à la première recherche)
+typedef struct
 {
-	// tableaux contentant les coordonnées X et Y des éléments des 2 serpents
-	int lesX1[TAILLE];
-	int lesY1[TAILLE];
-	int lesX2[TAILLE];
-	int lesY2[TAILLE];
+	unsigned int numeroRecherche;
+	unsigned int *marque;
+	bool *fermee;
+	int *g;
+	char *arrivee; // direction par laquelle la case a été atteinte
+	// tas agrandi au besoin (une case peut y entrer une fois par voisin)
+	tNoeud *tas;
+	int tailleTas;
+	int capaciteTas;
+	// plateaux bit à bit du remplissage de remplirDepuis (alloués au premier remplissage)
+	// et mots de ces plateaux touchés par le dernier remplissage, seuls à effacer au suivant
+	tBitboard atteintes;
+	tBitboard nouvelles;
+	long debutRempli;
+	long finRempli;
+} tAEtoile;
 
-	// représente la touche frappée par l'utilisateur attend la possible entrée de la touche arrêt
-	char touche;
+// état de l'algorithme D* Lite d'un serpent, conservé d'un tour à l'autre :
+// les distances à la pomme (g, rhs) sont calculées depuis la pomme vers la tête,
+// et seules les cases dont l'état a changé depuis le tour précédent sont reprises
+typedef struct
+{
+	bool initialise;
+	int xBut;    // pomme visée
+	int yBut;
+	int xDepart; // tête du serpent lors du dernier calcul
+	int yDepart;
+	int distancePortailDepart; // distance de la tête à l'issue la plus proche
+	int km;      // cumul des corrections de clé dues aux déplacements de la tête
+	// tableaux d'une valeur par case, alloués à la première recherche
+	int *g;
+	int *rhs;
+	bool *bloquee; // obstacles lors du dernier calcul
+	// file de priorité indexée : clé de chaque case et place dans le tas (-1 si absente)
+	int *cle1;
+	int *cle2;
+	int *place;
+	int *tas; // indices CASE(x, y) des cases
+	int tailleTas;
+} tDStar;
 
-	// direction courante des serpents (HAUT, BAS, GAUCHE ou DROITE)
-	char direction1;
-	char direction2;
+// un serpent : son corps, sa direction et son état, le plateau étant partagé par tous
+typedef struct
+{
+	// coordonnées X et Y des anneaux, parcourues circulairement : la tête est à l'indice tete,
+	// l'anneau suivant à l'indice tete + 1 modulo capacite, et ainsi de suite jusqu'à la queue ;
+	// la nouvelle tête est écrite juste avant l'ancienne, sans rien décaler, et les tableaux
+	// sont alloués avant la partie à la longueur maximale que le serpent peut atteindre
+	int *lesX;
+	int *lesY;
+	int capacite;
+	int tete;
+	// nombre d'anneaux (tête comprise) et anneaux restant à ajouter après une pomme
+	// (la queue reste en place pendant les déplacements qui les ajoutent)
+	int longueur;
+	int aGrandir;
 
-	// le plateau de jeu
-	tPlateau lePlateau;
+	// direction courante (HAUT, BAS, GAUCHE ou DROITE)
+	char direction;
 
-	//variables utiles aux interactions des serpents avec le pateau
-	bool collision1 = false;
-	bool collision2 = false;
-	bool gagne = false;
-	bool pommeMangee1 = false;
-	bool pommeMangee2 = false;
-	bool utiliserIssue1 = false;
-	bool utiliserIssue2 = false;
+	// stratégie de choix de direction (STRATEGIE_*)
+	int strategie;
 
-	// initialisation de la position du serpent 1: positionnement de la
-	// tête en (X_INITIAL, Y_INITIAL_SERPENT_1), puis des anneaux à sa gauche
-	for (int i = 0 ; i < TAILLE ; i++)
-	{
-		lesX1[i] = X_INITIAL - i;
-		lesY1[i] = Y_INITIAL_SERPENT_1;
-	}
-	// initialisation de la position du serpent 2: positionnement de la
-	// tête en (X_INITIAL, Y_INITIAL_SERPENT_2), puis des anneaux à sa droite
-	for (int i = 0 ; i < TAILLE ; i++)
-	{
-		lesX2[i] = X_INITIAL + i;
-		lesY2[i] = Y_INITIAL_SERPENT_2;
-	}
+	// case où arrivera la tête au prochain déplacement (voir annoncerDeplacements)
+	int annonce;
+	// directions classées lors du choix en parallèle : la direction retenue, puis les autres
+	// directions sans bordure, pavé ni corps, de la moins coûteuse à la plus coûteuse
+	// d'après couts ; la résolution des conflits y reprend une direction sans rien recalculer
+	int couts[4];
+	char replis[4];
+	int nbReplis;
 
-	// mise en place du plateau
-	initPlateau(lePlateau, lesX1, lesY1);
-	system("clear");
-	dessinerPlateau(lePlateau);
-	srand(time(NULL));
-	ajouterPomme(lePlateau, (nbPommes1+nbPommes2));
-
-	// initialisation : le serpent 1 se dirige vers la DROITE
-	// initialisation : le serpent 2 se dirige vers la GAUCHE
-	dessinerSerpent1(lesX1, lesY1);
-	dessinerSerpent2(lesX2, lesY2);
-	disable_echo();
-	direction1 = DROITE;
-	direction2 = GAUCHE;
-
-	// calcul la meilleur distance à l'initialisation
-	int meilleurDistance1 = calculDistance1(lesX1, lesY1, lesPommesX[(nbPommes1+nbPommes2)], lesPommesY[(nbPommes1+nbPommes2)]);
-	int meilleurDistance2 = calculDistance2(lesX2, lesY2, lesPommesX[(nbPommes1+nbPommes2)], lesPommesY[(nbPommes1+nbPommes2)]);
-
-	// boucle de jeu du serpent 1. Arret si touche STOP, si collision avec une bordure ou
-	// si toutes les pommes sont mangées
-	do
+	// recherche incrémentale D* Lite
+	tDStar dStar;
+
+	// pommes mangées et déplacements
+	int nbPommes;
+	int deplacements;
+
+	// interactions avec le plateau : un serpent en collision est éliminé,
+	// son corps est retiré du plateau si la partie continue sans lui
+	bool collision;
+	bool retire;
+	bool pommeMangee;
+} tSerpent;
+
+// threads qui choisissent en parallèle la direction des serpents pendant une partie
+// (créés à la première partie et conservés jusqu'à libererPartie) : à chaque tour,
+// le thread de la partie et les threads auxiliaires se partagent les serpents par tranches
+typedef struct tTravailPlanification tTravailPlanification;
+typedef struct
+{
+	int nbThreads; // threads auxiliaires, en plus du thread de la partie
+	pthread_t *threads;
+	tTravailPlanification *travaux;
+	pthread_mutex_t verrou;
+	pthread_cond_t debut; // signalée quand un tour est à planifier
+	pthread_cond_t fin;   // signalée quand tous les threads auxiliaires ont fini le tour
+	int tour;             // numéro du dernier tour à planifier
+	int nbTermines;
+	bool arret;
+	int suivant;          // premier serpent pas encore pris (incrémenté atomiquement)
+} tPlanificateurs;
+
+// état compact d'une partie pour les simulations de la stratégie mcts, copié d'un bloc
+// au début de chaque simulation : nombre de morceaux de serpent par case, corps des serpents
+// en tableaux circulaires d'indices CASE(x, y) et pomme courante (-1 quand il n'y en a plus)
+typedef struct
+{
+	int *cases;
+	int capacite;
+	int tete;
+	int longueur;
+	int aGrandir;
+	int pommes; // mangées depuis le début de la simulation (de la partie pour la stratégie alphabeta)
+	bool vivant;
+} tSerpentMcts;
+
+typedef struct
+{
+	unsigned char *occupation;
+	tSerpentMcts *serpents;
+	int nbSerpents;
+	int nbPommes;
+	int pomme;
+	int nbVivants;
+} tEtatMcts;
+
+// noeud de l'arbre de recherche : enfant atteint par chaque direction (-1 si pas encore créé),
+// nombre de simulations passées par le noeud et somme de leurs gains
+typedef struct
+{
+	int enfants[4];
+	int visites;
+	double gains;
+} tNoeudMcts;
+
+// threads de la stratégie mcts (créés à la première partie où un serpent la joue et conservés
+// jusqu'à libererPartie) : à chaque recherche, chacun construit son propre arbre depuis
+// l'état racine jusqu'à l'échéance, le thread qui a lancé la recherche compris
+typedef struct tTravailMcts tTravailMcts;
+typedef struct
+{
+	int nbThreads; // threads auxiliaires, en plus du thread qui lance la recherche
+	pthread_t *threads;
+	tTravailMcts *travaux; // un par thread auxiliaire, plus celui du thread qui lance la recherche
+	pthread_mutex_t verrou;
+	pthread_mutex_t recherche; // une seule recherche à la fois
+	pthread_cond_t debut;      // signalée quand une recherche est lancée
+	pthread_cond_t fin;        // signalée quand tous les threads auxiliaires ont fini la recherche
+	int tour;                  // numéro de la dernière recherche lancée
+	int nbTermines;
+	bool arret;
+	tEtatMcts racine;
+	int numero; // serpent pour lequel la recherche est faite
+	struct timespec echeance;
+} tMcts;
+
+// entrée de la table de transposition de la stratégie alphabeta : clé de Zobrist complète
+// de la position (les autres serpents compris, elle reste donc valable aux tours suivants),
+// recherche qui l'a écrite (les entrées des recherches passées sont remplacées les premières),
+// valeur obtenue à cette profondeur et meilleure direction trouvée (0 à 3, à partir de HAUT)
+typedef struct
+{
+	uint64_t cle;
+	unsigned int recherche;
+	short valeur;
+	signed char profondeur;
+	unsigned char coup;
+} tEntreeAB;
+
+// ce que deplacerDuel modifie, pour y revenir : les deux serpents, la pomme et la clé,
+// et pour chaque serpent qui a avancé, sa nouvelle tête, la queue libérée (-1 s'il grandit)
+// et l'ancien contenu de la place de la tête dans son tableau circulaire
+typedef struct
+{
+	tSerpentMcts serpents[2];
+	int pomme;
+	int nbPommes;
+	uint64_t cle;
+	bool avance[2];
+	int tete[2];
+	int queue[2];
+	int ecrase[2];
+} tAnnulationAB;
+
+// état de la stratégie alphabeta : le duel en cours (plateau recopié, le serpent qui cherche
+// à l'indice 0 et son adversaire à l'indice 1, avec la même représentation compacte que
+// la stratégie mcts), sa clé de Zobrist tenue à jour coup par coup, et la table de transposition
+// gardée d'une recherche à l'autre (allouées à la première recherche)
+typedef struct
+{
+	pthread_mutex_t recherche; // une seule recherche à la fois
+	tEntreeAB *table;          // TAILLE_TABLE_AB entrées
+	unsigned int numeroRecherche;
+	unsigned char *occupation;
+	tSerpentMcts serpents[2];
+	int numeros[2];
+	int capacite;
+	int nbPommes;
+	int pomme;
+	uint64_t cle;
+	struct timespec echeance;
+	long noeuds;
+	bool interrompue;
+} tAlphaBeta;
+
+// en-tête d'un fichier du cache des tables de la carte, suivi des tableaux (au format
+// de la machine qui l'a écrit) : le fichier n'est utilisé que si l'en-tête correspond
+// exactement à la carte courante, nombre (cases libres ou longueur du cycle) excepté
+typedef struct
+{
+	char magie[8];
+	int32_t version;
+	int32_t contenu; // CACHE_DISTANCES ou CACHE_CYCLE
+	int32_t tailleEntier;
+	int32_t largeur;
+	int32_t hauteur;
+	int32_t xIssues;
+	int32_t yIssues;
+	int32_t taillePaves;
+	int32_t pavesX[NB_PAVES];
+	int32_t pavesY[NB_PAVES];
+	int32_t nombre;
+	uint64_t cle;
+} tEnteteCache;
+
+// fichier du répertoire du cache, pour la suppression des moins récemment utilisés
+typedef struct
+{
+	char nom[PATH_MAX];
+	long long taille;
+	time_t date; // dernière modification, avancée à chaque utilisation
+} tFichierCache;
+
+// arête du graphe abstrait de la recherche hiérarchique, et entrée de son tas
+typedef struct
+{
+	int arrivee;
+	int cout;
+} tAreteHpa;
+
+typedef struct
+{
+	int distance;
+	int noeud;
+} tPaireHpa;
+
+// recherche hiérarchique de la stratégie heuristique : le plateau est découpé en grappes
+// de TAILLE_GRAPPE x TAILLE_GRAPPE cases ; les noeuds du graphe abstrait sont les cases de part
+// et d'autre des passages entre grappes voisines et des issues, rangés grappe par grappe
+// (ceux de la grappe g de premierNoeud[g] à premierNoeud[g + 1] exclu), et les arêtes de chaque
+// noeud (de premiereArete[n] à premiereArete[n + 1] exclu) vont à l'autre côté de son passage
+// et aux noeuds de sa grappe, avec la longueur du plus court chemin qui ne la quitte pas.
+// Le graphe est calculé pour la disposition des pavés pavesX/Y et gardé d'une partie à l'autre ;
+// la route vers la pomme courante donne pour chaque noeud sa distance à la pomme et le noeud
+// suivant sur le chemin (-1 : la pomme est dans sa grappe), recalculée à chaque pomme
+typedef struct
+{
+	bool calcule;
+	int pavesX[NB_PAVES];
+	int pavesY[NB_PAVES];
+	int nbGrappesX;
+	int nbGrappesY;
+	int nbNoeuds;
+	int *caseNoeud;
+	int *premierNoeud;
+	int *premiereArete;
+	tAreteHpa *aretes;
+	bool routeAJour;
+	int *distancePomme;
+	int *suivant;
+	tPaireHpa *tas;
+	int tailleTas;
+	int capaciteTas;
+} tHpa;
+
+// histogramme des durées d'une phase du tour, en nanosecondes : les seaux couvrent
+// [0, 8[ un par un, puis chaque puissance de 2 en SOUS_SEAUX tranches égales
+typedef struct
+{
+	long long comptes[NB_SEAUX];
+	long long nbMesures;
+	long long maximum;
+} tHistogramme;
+
+// contexte d'une partie : tout l'état du jeu, aucune variable globale n'est modifiée
+// pendant une partie, plusieurs contextes peuvent donc être joués en parallèle
+typedef struct
+{
+	// le plateau de jeu (une case par CASE(x, y))
+	char *plateau;
+
+	// occupation du plateau bit à bit : bordures, pavés, cases occupées par au moins
+	// un morceau de serpent (tête comprise) et queues des serpents,
+	// tenue à jour par initPlateau, poserAnneau, retirerAnneau et progresser
+	tBitboard murs;
+	tBitboard paves;
+	tBitboard corps;
+	tBitboard queues;
+	// masques des colonnes 1 et largeurPlateau, pour le remplissage bit à bit
+	tBitboard colonneGauche;
+	tBitboard colonneDroite;
+
+	// index spatial partagé par tous les serpents : nombre de morceaux de serpent présents
+	// sur chaque case, incrémenté quand une tête arrive et décrémenté quand une queue part,
+	// et nombre de têtes qui y arriveront au prochain tour si leur serpent garde sa direction
+	// (rempli pendant le choix des directions seulement)
+	unsigned char *occupation;
+	unsigned char *annonces;
+
+	// cases dont l'occupation a changé pendant les derniers déplacements (indices CASE(x, y)),
+	// reprises au tour suivant par les recherches D* Lite ; tableau agrandi au besoin
+	int *casesModifiees;
+	int nbCasesModifiees;
+	int capaciteCasesModifiees;
+
+	// les serpents, joués dans l'ordre de leur numéro, et le nombre de ceux encore en jeu
+	int nbSerpents;
+	tSerpent *serpents;
+	int nbVivants;
+
+	// nombre de threads qui choisissent les directions (1 : pas de thread auxiliaire)
+	int nbPlanificateurs;
+	tPlanificateurs planificateurs;
+	// cases retenues par les serpents déjà départagés, pendant la résolution des conflits
+	tBitboard reservees;
+
+	// position de la pomme courante et distance de chaque case à cette pomme
+	// en contournant bordures et pavés et en passant par les issues
+	// (distancesPomme et la file du parcours sont alloués au premier calcul)
+	int xPomme;
+	int yPomme;
+	int *distancesPomme;
+	int *fileChamp;
+	bool champAJour;
+
+	// cycle hamiltonien de la stratégie hamilton : rang de chaque case le long du cycle
+	// (-1 hors du cycle) et cases du cycle dans l'ordre ; calculé pour la disposition
+	// des pavés cyclePavesX/Y et gardé d'une partie à l'autre tant qu'elle ne change pas
+	int *rangCycle;
+	int *casesCycle;
+	int longueurCycle;
+	bool cycleCalcule;
+	int cyclePavesX[NB_PAVES];
+	int cyclePavesY[NB_PAVES];
+	// projection du fichier du cache d'où viennent rangCycle et casesCycle (NULL s'ils ont
+	// été calculés), de même pour la table des distances
+	void *projectionCycle;
+	size_t tailleProjectionCycle;
+	void *projectionDistances;
+	size_t tailleProjectionDistances;
+
+	// distances entre toutes les paires de cases libres (bordures et pavés contournés,
+	// issues comprises), sur 16 bits : indiceLibre numérote les cases libres (-1 pour les
+	// autres) et la distance entre les cases libres i >= j est rangée à l'indice
+	// i * (i + 1) / 2 + j, la table étant symétrique ; calculée pour la disposition des pavés
+	// distancesPavesX/Y quand une stratégie l'interroge, si la carte n'a pas plus de
+	// NB_LIBRES_MAX_DISTANCES cases libres (distancesPaires vaut NULL sinon)
+	uint16_t *distancesPaires;
+	int *indiceLibre;
+	int nbLibres;
+	bool distancesCalculees;
+	int distancesPavesX[NB_PAVES];
+	int distancesPavesY[NB_PAVES];
+
+	// graphe abstrait de la stratégie heuristique et route vers la pomme courante
+	tHpa hpa;
+
+	// stratégie mcts : durée de la recherche à chaque tour (en nanosecondes),
+	// nombre de threads qui simulent (1 : pas de thread auxiliaire) et ces threads
+	long budgetMcts;
+	int nbThreadsMcts;
+	tMcts mcts;
+
+	// stratégie alphabeta : durée de la recherche à chaque tour (en nanosecondes) et son état
+	long budgetAlphaBeta;
+	tAlphaBeta alphaBeta;
+
+	// mémoire de la stratégie A* (celle du thread de la partie,
+	// chaque thread de planification auxiliaire a la sienne)
+	tAEtoile aEtoile;
+
+	// pommes mangées par l'ensemble des serpents et tours joués
+	int nbPommes;
+	int nbTours;
+
+	// positions des pommes et des coins supérieurs gauches des pavés de cette partie
+	int lesPommesX[NB_POMMES];
+	int lesPommesY[NB_POMMES];
+	int lesPavesX[NB_PAVES];
+	int lesPavesY[NB_PAVES];
+
+	// résultat de la partie (EGALITE ou numéro du serpent vainqueur)
+	int vainqueur;
+
+	// cadence de jeu en mode affichage : durée d'un tour en nanosecondes (ATTENTE divisée
+	// par le multiplicateur de vitesse) et nombre de tours dont le calcul a dépassé cette durée
+	long periode;
+	int toursEnRetard;
+
+	// durées des phases de chaque tour, cumulées sur toutes les parties jouées
+	// avec ce contexte quand mesurerLatences est vrai
+	bool mesurerLatences;
+	tHistogramme latences[NB_PHASES];
+
+	// anneaux ajoutés au serpent par pomme mangée (0 : les serpents gardent TAILLE anneaux) ;
+	// en croissance, un serpent meurt aussi en heurtant son propre corps
+	int croissance;
+
+	// sans affichage (mode simulation ou tournoi), aucune entrée/sortie terminal
+	// ni temporisation n'est faite
+	bool affichage;
+
+	// fenêtre affichée : coin supérieur gauche (case du plateau affichée en (1, 1)) et taille
+	int xVue;
+	int yVue;
+	int largeurVue;
+	int hauteurVue;
+	// image à afficher au prochain rafraîchissement (remplie par afficher et effacer)
+	// et contenu actuel du terminal, comparés case par case par rafraichirEcran
+	tVue image;
+	tVue ecran;
+} tPartie;
+
+// travail d'un thread de planification auxiliaire
+struct tTravailPlanification
+{
+	tPartie *partie;
+	tAEtoile aEtoile; // mémoire A* propre au thread
+};
+
+// travail d'un thread de la stratégie mcts : son état de simulation et son arbre
+struct tTravailMcts
+{
+	tPartie *partie;
+	tEtatMcts etat;
+	tNoeudMcts *noeuds; // NB_NOEUDS_MCTS noeuds, la racine à l'indice 0
+	int nbNoeuds;
+	unsigned int graine;
+	long iterations; // simulations de la dernière recherche
+	char *directions; // directions des serpents pendant un tour simulé
+};
+
+// bilan cumulé d'un ensemble de parties du mode tournoi
+typedef struct
+{
+	int nbParties;
+	int victoires1;
+	int victoires2; // victoires des serpents 2 à nbSerpents
+	int egalites;
+	int abandons; // parties arrêtées à LIMITE_DEPLACEMENTS
+	long long deplacements1;
+	long long deplacements2; // cumulés sur les serpents 2 à nbSerpents
+	long long pommes1;
+	long long pommes2;
+} tBilanTournoi;
+
+// travail confié à un thread du mode tournoi
+typedef struct
+{
+	const tPartie *modele; // réglages communs à toutes les parties (serpents et stratégies)
+	int numero;
+	int nbThreads;
+	int nbParties;
+	tBilanTournoi bilan;
+} tTravailTournoi;
+
+/* Déclaration des fonctions et procédures*/
+// Déroulement d'une partie
+void initPartie(tPartie *partie, int nbSerpents);
+void libererPartie(tPartie *partie);
+void *allouerMemoire(size_t taille);
+void afficherUsage(const char *programme);
+int jouerPartie(tPartie *partie);
+void preparerPartie(tPartie *partie);
+bool jouerTour(tPartie *partie);
+// Fonctions du mode tournoi
+void genererPartieAleatoire(tPartie *partie, unsigned int graine);
+bool positionPaveValide(int x, int y);
+bool premierePositionPave(int *x, int *y);
+void jouerTournoi(const tPartie *modele, int nbParties, int nbThreads, tBilanTournoi *bilan);
+void *threadTournoi(void *arg);
+void afficherBilanTournoi(const tPartie *modele, tBilanTournoi *bilan);
+// Fonctions du banc d'essai
+void jouerBancEssai(const tPartie *modele);
+void preparerEtatBanc(tPartie *partie, int etat);
+double mesurerFonctionBanc(tPartie *partie, int fonction, long nbAppels);
+bool placerCarreBanc(tPartie *partie);
+bool carreLibreBanc(tPartie *partie, int xTete, int yTete);
+// Mesure des latences par tour
+long long ecartNs(const struct timespec *debut, const struct timespec *fin);
+void enregistrerDuree(tHistogramme *histogramme, long long duree);
+long long quantileHistogramme(const tHistogramme *histogramme, double q);
+void afficherLatences(FILE *sortie, const tPartie *partie);
+void ecrireLatences(const char *fichier, const tPartie *partie);
+// Fonctions de choix de la direction
+void planifierTour(tPartie *partie);
+void planifierSerpents(tPartie *partie, tAEtoile *aEtoile);
+void demarrerPlanificateurs(tPartie *partie);
+void arreterPlanificateurs(tPartie *partie);
+void *threadPlanificateur(void *arg);
+void preparerChamp(tPartie *partie);
+void choisirDirection(tPartie *partie, int numero, tAEtoile *aEtoile);
+void evaluerDirectionsChamp(tPartie *partie, int numero);
+void classerReplis(tPartie *partie, int numero);
+char directionRepli(tPartie *partie, int numero);
+void annoncerDeplacements(tPartie *partie);
+void corrigerAnnonce(tPartie *partie, int numero);
+void retirerAnnonces(tPartie *partie);
+void positionSuivante(int x, int y, char direction, int *xSuivant, int *ySuivant);
+void calculerChampDistances(tPartie *partie, int xPomme, int yPomme);
+char directionChamp(tPartie *partie, int numero);
+char directionAEtoile(tPartie *partie, int numero, tAEtoile *aEtoile);
+void nouvelleRechercheAEtoile(tAEtoile *aEtoile);
+void libererAEtoile(tAEtoile *aEtoile);
+int heuristiqueAEtoile(int x, int y, int xBut, int yBut, int distancePortailBut);
+int distanceIssuLaPlusProche(int x, int y);
+void insererTas(tAEtoile *aEtoile, int f, int g, int x, int y);
+tNoeud extraireTas(tAEtoile *aEtoile);
+char directionDStar(tPartie *partie, int numero, tAEtoile *aEtoile);
+void initialiserDStar(tPartie *partie, tDStar *dStar, int xDepart, int yDepart);
+bool caseBloqueeDStar(tPartie *partie, tDStar *dStar, int x, int y);
+void reprendreCaseDStar(tPartie *partie, tDStar *dStar, int x, int y);
+void mettreAJourCaseDStar(tDStar *dStar, int x, int y);
+void calculerCheminDStar(tDStar *dStar);
+void calculerCleDStar(tDStar *dStar, int x, int y, int *cle1, int *cle2);
+void placerTasDStar(tDStar *dStar, int x, int y, int cle1, int cle2);
+void retirerTasDStar(tDStar *dStar, int x, int y);
+void remonterTasDStar(tDStar *dStar, int i);
+void descendreTasDStar(tDStar *dStar, int i);
+int lireStrategie(const char *nom);
+char directionPlusGrandEspace(tPartie *partie, int numero, tAEtoile *aEtoile);
+void preparerCycle(tPartie *partie);
+void calculerCycleHamiltonien(tPartie *partie);
+char directionHamilton(tPartie *partie, int numero, tAEtoile *aEtoile);
+bool caseDetourCycle(tPartie *partie, int x, int y);
+char raccourciPomme(tPartie *partie, int numero, int limite);
+char directionChampSure(tPartie *partie, int numero, tAEtoile *aEtoile);
+// Distances entre toutes les cases libres
+void preparerDistances(tPartie *partie);
+void calculerDistancesPaires(tPartie *partie);
+int distanceCases(tPartie *partie, int c1, int c2);
+// Recherche hiérarchique
+void etapeHpa(tPartie *partie, int numero, tAEtoile *aEtoile, int *xCible, int *yCible);
+int grappeCase(const tHpa *hpa, int x, int y);
+void parcourirGrappe(tPartie *partie, int x, int y, int *distances, int *file);
+void preparerGrapheHpa(tPartie *partie);
+void construireGrapheHpa(tPartie *partie);
+int relierGrappesHpa(tPartie *partie, int *cases);
+void preparerRouteHpa(tPartie *partie);
+void calculerRouteHpa(tPartie *partie);
+void insererTasHpa(tHpa *hpa, int distance, int noeud);
+tPaireHpa extraireTasHpa(tHpa *hpa);
+void libererHpa(tHpa *hpa);
+// Cache des tables de la carte
+bool chargerCycle(tPartie *partie);
+bool chargerDistances(tPartie *partie);
+void libererCycle(tPartie *partie);
+void libererDistances(tPartie *partie);
+size_t tailleDonneesCache(int contenu, int nombre);
+void remplirEnteteCache(tPartie *partie, int contenu, int nombre, tEnteteCache *entete);
+void nomFichierCache(tPartie *partie, int contenu, char *nom, size_t taille);
+char *projeterCache(tPartie *partie, int contenu, int *nombre, void **projection, size_t *taille);
+void ecrireCache(tPartie *partie, int contenu, int nombre, const void *tableau1, size_t taille1,
+                 const void *tableau2, size_t taille2);
+void limiterCache(size_t tailleAjoutee);
+int comparerFichiersCache(const void *a, const void *b);
+uint64_t cleCarte(tPartie *partie);
+// Fonctions de la recherche Monte-Carlo
+char directionMcts(tPartie *partie, int numero);
+void rechercherMcts(tTravailMcts *travail);
+int choisirActionMcts(tPartie *partie, tTravailMcts *travail, int noeud);
+char directionParDefautMcts(tPartie *partie, const tEtatMcts *etat, int numero, unsigned int *graine);
+bool directionLibreMcts(tPartie *partie, const tEtatMcts *etat, int numero, char direction);
+void deplacerSerpentsMcts(tPartie *partie, tEtatMcts *etat, const char *directions);
+void retirerSerpentMcts(tEtatMcts *etat, int numero);
+int casePommeSimulee(tPartie *partie, const unsigned char *occupation, int iPomme);
+double evaluerEtatMcts(tPartie *partie, const tEtatMcts *racine, const tEtatMcts *etat, int numero, int nbTours);
+void creerEtatMcts(tPartie *partie, tEtatMcts *etat);
+void libererEtatMcts(tEtatMcts *etat);
+void initialiserEtatMcts(tPartie *partie, tEtatMcts *etat);
+void copierEtatMcts(tEtatMcts *destination, const tEtatMcts *source);
+void demarrerMcts(tPartie *partie);
+void arreterMcts(tPartie *partie);
+void *threadMcts(void *arg);
+// Fonctions de la recherche alpha-bêta
+char directionAlphaBeta(tPartie *partie, int numero);
+int rechercherDuel(tPartie *partie, int profondeur, int ply, int *meilleurCoup);
+int valeurJeuSimultane(int valeurs[4][4], int *meilleurCoup);
+int valeurVersTableAB(int valeur, int ply);
+int valeurDepuisTableAB(int valeur, int ply);
+int evaluerDuel(tPartie *partie, int ply);
+int distanceDuel(tPartie *partie, const tSerpentMcts *serpent);
+void deplacerDuel(tPartie *partie, const char *coups, tAnnulationAB *annulation);
+void annulerDuel(tAlphaBeta *ab, const tAnnulationAB *annulation);
+void initialiserDuel(tPartie *partie, int numero, int adversaire);
+uint64_t cleDuel(const tAlphaBeta *ab);
+uint64_t cleZobrist(int c, int serpent, int nature);
+uint64_t clePommeZobrist(int iPomme);
+uint64_t melanger64(uint64_t x);
+// Fonctions bit à bit sur le plateau
+void creerBitboard(tBitboard *bitboard);
+void libererBitboard(tBitboard *bitboard);
+void copierBitboard(tBitboard *destination, const tBitboard *source);
+void viderBitboard(tBitboard *bitboard);
+void activerBit(tBitboard *bitboard, int x, int y);
+void desactiverBit(tBitboard *bitboard, int x, int y);
+bool testerBit(const tBitboard *bitboard, int x, int y);
+int compterBits(const tBitboard *bitboard);
+uint64_t motLibre(tPartie *partie, size_t i);
+void casesLibres(tPartie *partie, tBitboard *libres);
+int compterCasesLibres(tPartie *partie);
+uint64_t motBorne(const tBitboard *bitboard, long i, long debut, long fin);
+void preparerRemplissage(tAEtoile *aEtoile);
+int remplirDepuis(tPartie *partie, int x, int y, int borne, tAEtoile *aEtoile);
+// Fonctions plateau, pommes et pavés
+int indiceQueue(const tSerpent *serpent);
+void initPlateau(tPartie *partie);
+void dessinerPlateau(tPartie *partie);
+void placerVue(tPartie *partie, int x, int y);
+void ajouterPomme(tPartie *partie, int iPomme);
+void placerPaves(tPartie *partie);
+void afficher(tPartie *partie, int x, int y, char car);
+void effacer(tPartie *partie, int x, int y);
+void rafraichirEcran(tPartie *partie);
+// Fonctions relatives aux serpents
+void placerSerpents(tPartie *partie);
+void coucherSerpent(tPartie *partie, int numero, int xTete, int yTete, char direction);
+char symboleTete(int numero);
+void poserAnneau(tPartie *partie, int x, int y);
+void retirerAnneau(tPartie *partie, int x, int y);
+void noterCaseModifiee(tPartie *partie, int x, int y);
+void dessinerSerpent(tPartie *partie, int numero);
+void directionSerpent(tPartie *partie, int numero, int x, int y, tAEtoile *aEtoile);
+int mesurerEspace(tPartie *partie, int numero, int x, int y, int borne, tAEtoile *aEtoile, bool *queueAtteinte);
+bool verifierCollisionProchainDeplacement(tPartie *partie, int numero, char prochaineDirection);
+void progresser(tPartie *partie, int numero);
+int compterAnneaux(const tSerpent *serpent, int x, int y);
+void retirerSerpent(tPartie *partie, int numero);
+// Fonctions boites noires
+void gotoxy(int x, int y);
+void activerModeBrut(struct termios *terminalInitial);
+void restaurerTerminal(const struct termios *terminalInitial);
+char attendreTouche(const struct timespec *echeance);
+char attendreFinTour(tPartie *partie, struct timespec *echeance);
+void avancerEcheance(struct timespec *echeance, long duree);
+
+// Main du programme
+int main(int argc, char *argv[])
+{
+	int mode = MODE_JEU;
+	int nbParties = NB_PARTIES_SIMULATION;
+	int nbThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	int strategie1 = STRATEGIE_CHAMP;
+	int strategie2 = STRATEGIE_CHAMP;
+	int nbSerpents = NB_SERPENTS;
+	int nbPlanificateurs = 1;
+	long periode = (long)ATTENTE * 1000;
+	bool issuesDonnees = false;
+	bool latences = false;
+	int croissance = 0;
+	long budgetMcts = BUDGET_MCTS;
+	// threads de la stratégie mcts (en tournoi, partagés entre les threads du tournoi)
+	int nbThreadsMcts = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	long budgetAlphaBeta = BUDGET_ALPHABETA;
+	const char *fichierLatences = NULL;
+
+	// lecture des options de la ligne de commande
+	for (int i = 1 ; i < argc ; i++)
 	{
-		/* déplacements du serpent 1*/
-		if (meilleurDistance1 == HAUT) // se dirige vers le trou du haut puis quand il s'est téléporté avance vers la pomme
+		if (strcmp(argv[i], "--simulation") == 0)
 		{
-			if (utiliserIssue1)
+			mode = MODE_SIMULATION;
+			if (i + 1 < argc && argv[i + 1][0] != '-')
 			{
-				directionSerpent1(lesX1, lesY1, lePlateau, &direction1, lesPommesX[(nbPommes1+nbPommes2)], lesPommesY[(nbPommes1+nbPommes2)], lesX2, lesY2, direction2);
-			}
-			else
-			{
-				directionSerpent1(lesX1, lesY1, lePlateau, &direction1, ISSUE_HAUT_X, ISSUE_HAUT_Y, lesX2, lesY2, direction2);
+				nbParties = atoi(argv[++i]);
 			}
 		}
-		if (meilleurDistance1 == BAS) // se dirige vers le trou du bas puis quand il s'est téléporté avance vers la pomme
+		else if (strcmp(argv[i], "--tournoi") == 0 && i + 1 < argc)
 		{
-			if (utiliserIssue1)
-			{
-				directionSerpent1(lesX1, lesY1, lePlateau, &direction1, lesPommesX[(nbPommes1+nbPommes2)], lesPommesY[(nbPommes1+nbPommes2)], lesX2, lesY2, direction2);
-			}
-			else
+			mode = MODE_TOURNOI;
+			nbParties = atoi(argv[++i]);
+			if (i + 1 < argc && argv[i + 1][0] != '-')
 			{
-				directionSerpent1(lesX1, lesY1, lePlateau, &direction1, ISSUE_BAS_X, ISSUE_BAS_Y, lesX2, lesY2, direction2);
+				nbThreads = atoi(argv[++i]);
 			}
 		}
-		if (meilleurDistance1 == GAUCHE) // se dirige vers le trou de gauche puis quand il s'est téléporté avance vers la pomme
+		else if (strcmp(argv[i], "--banc") == 0)
 		{
-			if (utiliserIssue1)
-			{
-				directionSerpent1(lesX1, lesY1, lePlateau, &direction1, lesPommesX[(nbPommes1+nbPommes2)], lesPommesY[(nbPommes1+nbPommes2)], lesX2, lesY2, direction2);
-			}
-			else
-			{
-				directionSerpent1(lesX1, lesY1, lePlateau, &direction1, ISSUE_GAUCHE_X, ISSUE_GAUCHE_Y, lesX2, lesY2, direction2);
-			}
+			mode = MODE_BANC;
+		}
+		else if (strcmp(argv[i], "--croissance") == 0 && i + 1 < argc)
+		{
+			croissance = atoi(argv[++i]);
 		}
-		if (meilleurDistance1 == DROITE) // se dirige vers le trou de droite puis quand il s'est téléporté avance vers la pomme
+		else if (strcmp(argv[i], "--latences") == 0)
 		{
-			if (utiliserIssue1)
+			// durées des phases de chaque tour, recopiées dans un fichier s'il est donné
+			latences = true;
+			if (i + 1 < argc && argv[i + 1][0] != '-')
 			{
-				directionSerpent1(lesX1, lesY1, lePlateau, &direction1, lesPommesX[(nbPommes1+nbPommes2)], lesPommesY[(nbPommes1+nbPommes2)], lesX2, lesY2, direction2);
+				fichierLatences = argv[++i];
 			}
-			else
+		}
+		else if (strcmp(argv[i], "--vitesse") == 0 && i + 1 < argc)
+		{
+			// multiplicateur de vitesse du jeu affiché : 2 joue deux fois plus vite
+			double vitesse = atof(argv[++i]);
+			if (vitesse <= 0)
 			{
-				directionSerpent1(lesX1, lesY1, lePlateau, &direction1, ISSUE_DROITE_X, ISSUE_DROITE_Y, lesX2, lesY2, direction2);
+				afficherUsage(argv[0]);
+				return EXIT_FAILURE;
 			}
+			periode = (long)(ATTENTE * 1000 / vitesse);
 		}
-		if (meilleurDistance1 == CHEMIN_POMME) // sinon se dirige uniquement vers la pomme
+		else if (strcmp(argv[i], "--strategie1") == 0 && i + 1 < argc)
 		{
-			directionSerpent1(lesX1, lesY1, lePlateau, &direction1, lesPommesX[(nbPommes1+nbPommes2)], lesPommesY[(nbPommes1+nbPommes2)], lesX2, lesY2, direction2);
+			strategie1 = lireStrategie(argv[++i]);
 		}
-
-		/* déplacements du serpent 2*/
-		if (meilleurDistance2 == HAUT) // se dirige vers le trou du haut puis quand il s'est téléporté avance vers la pomme
+		else if (strcmp(argv[i], "--strategie2") == 0 && i + 1 < argc)
 		{
-			if (utiliserIssue2)
-			{
-				directionSerpent2(lesX2, lesY2, lePlateau, &direction2, lesPommesX[(nbPommes1+nbPommes2)], lesPommesY[(nbPommes1+nbPommes2)], lesX1, lesY1, direction2);
-			}
-			else
-			{
-				directionSerpent2(lesX2, lesY2, lePlateau, &direction2, ISSUE_HAUT_X, ISSUE_HAUT_Y, lesX1, lesY1, direction2);
-			}
+			strategie2 = lireStrategie(argv[++i]);
 		}
-		if (meilleurDistance2 == BAS) // se dirige vers le trou du bas puis quand il s'est téléporté avance vers la pomme
+		else if (strcmp(argv[i], "--serpents") == 0 && i + 1 < argc)
 		{
-			if (utiliserIssue2)
-			{
-				directionSerpent2(lesX2, lesY2, lePlateau, &direction2, lesPommesX[(nbPommes1+nbPommes2)], lesPommesY[(nbPommes1+nbPommes2)], lesX1, lesY1, direction2);
-			}
-			else
-			{
-				directionSerpent2(lesX2, lesY2, lePlateau, &direction2, ISSUE_BAS_X, ISSUE_BAS_Y, lesX1, lesY1, direction2);
-			}
+			nbSerpents = atoi(argv[++i]);
 		}
-		if (meilleurDistance2 == GAUCHE) // se dirige vers le trou de gauche puis quand il s'est téléporté avance vers la pomme
+		else if (strcmp(argv[i], "--planificateurs") == 0 && i + 1 < argc)
 		{
-			if (utiliserIssue2)
-			{
-				directionSerpent2(lesX2, lesY2, lePlateau, &direction2, lesPommesX[(nbPommes1+nbPommes2)], lesPommesY[(nbPommes1+nbPommes2)], lesX1, lesY1, direction2);
-			}
-			else
-			{
-				directionSerpent2(lesX2, lesY2, lePlateau, &direction2, ISSUE_GAUCHE_X, ISSUE_GAUCHE_Y, lesX1, lesY1, direction2);
-			}
+			nbPlanificateurs = atoi(argv[++i]);
 		}
-		if (meilleurDistance2 == DROITE) // se dirige vers le trou de droite puis quand il s'est téléporté avance vers la pomme
+		else if (strcmp(argv[i], "--budget-mcts") == 0 && i + 1 < argc)
 		{
-			if (utiliserIssue2)
-			{
-				directionSerpent2(lesX2, lesY2, lePlateau, &direction2, lesPommesX[(nbPommes1+nbPommes2)], lesPommesY[(nbPommes1+nbPommes2)], lesX1, lesY1, direction2);
-			}
-			else
-			{
-				directionSerpent2(lesX2, lesY2, lePlateau, &direction2, ISSUE_DROITE_X, ISSUE_DROITE_Y, lesX1, lesY1, direction2);
-			}
+			budgetMcts = atol(argv[++i]);
 		}
-		if (meilleurDistance2 == CHEMIN_POMME) // sinon se dirige uniquement vers la pomme
+		else if (strcmp(argv[i], "--threads-mcts") == 0 && i + 1 < argc)
 		{
-			directionSerpent2(lesX2, lesY2, lePlateau, &direction2, lesPommesX[(nbPommes1+nbPommes2)], lesPommesY[(nbPommes1+nbPommes2)], lesX1, lesY1, direction2);
+			nbThreadsMcts = atoi(argv[++i]);
 		}
-
-		// deplacement du serpent à chaque fois et incrémentation du compteur de déplacements
-		progresser1(lesX1, lesY1, direction1, lePlateau, &collision1, &pommeMangee1, &utiliserIssue1);
-		deplacements1++; /* ajout d'un déplacement pour le serpent 1*/
-		progresser2(lesX2, lesY2, direction2, lePlateau, &collision2, &pommeMangee2, &utiliserIssue2);
-		deplacements2++; /* ajout d'un déplacement pour le serpent 2*/
-
-
-		// Ajoute une pomme au compteur de pomme quand elle est mangée et arrete le jeu si score atteint 10
-		if (pommeMangee1)
+		else if (strcmp(argv[i], "--budget-alphabeta") == 0 && i + 1 < argc)
 		{
-			nbPommes1++;
-			if ((nbPommes1+nbPommes2) == NB_POMMES) {
-				gagne = true;
-				utiliserIssue1 = false;
-			}
-			if (!gagne)
-			{
-				ajouterPomme(lePlateau, (nbPommes1+nbPommes2));
-				// recalcul la meilleure position après l'apparition d'une nouvelle pomme
-				meilleurDistance1 = calculDistance1(lesX1, lesY1, lesPommesX[(nbPommes1+nbPommes2)], lesPommesY[(nbPommes1+nbPommes2)]); 
-				pommeMangee1 = false;
-			}
+			budgetAlphaBeta = atol(argv[++i]);
 		}
-		else if (pommeMangee2){
-			nbPommes2++;
-			if ((nbPommes1+nbPommes2) == NB_POMMES) {
-				gagne = true;
-				utiliserIssue2 = false;
-			}
-			if (!gagne)
-			{
-				ajouterPomme(lePlateau, (nbPommes1+nbPommes2));
-				// recalcul la meilleure position après l'apparition d'une nouvelle pomme
-				meilleurDistance2 = calculDistance2(lesX2, lesY2, lesPommesX[(nbPommes1+nbPommes2)], lesPommesY[(nbPommes1+nbPommes2)]); 
-				pommeMangee2 = false;
-			}
+		else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc)
+		{
+			repertoireCache = argv[++i];
 		}
-
-		if (!gagne)
+		else if (strcmp(argv[i], "--plateau") == 0 && i + 2 < argc)
 		{
-			if (!collision1 && !collision2)
-			{
-				usleep(ATTENTE);
-				if (kbhit() == 1)
-				{
-					touche = getchar();
-				}
-			}
+			largeurPlateau = atoi(argv[++i]);
+			hauteurPlateau = atoi(argv[++i]);
 		}
-	} while (touche != STOP && !collision1 && !collision2 && !gagne); 
-
-	enable_echo();
-	gotoxy(1, HAUTEUR_PLATEAU + 1);
-
-	// afficher les performances du programme
-	printf("Serpent 1 : %d déplacements et %d pommes mangées\n", deplacements1, nbPommes1);
-	printf("Serpent 2 : %d déplacements et %d pommes mangées\n", deplacements2, nbPommes2);
-
-	return EXIT_SUCCESS;
-}
-
-
-/************************************************
-		FONCTIONS ET PROCEDURES DU CODE 	   
+		else if (strcmp(argv[i], "--issues") == 0 && i + 2 < argc)
+		{
+			xIssues = atoi(argv[++i]);
+			yIssues = atoi(argv[++i]);
+			issuesDonnees = true;
+		}
+		else if (strcmp(argv[i], "--paves") == 0 && i + 1 < argc)
+		{
+			taillePaves = atoi(argv[++i]);
+		}
+		else
+		{
+			afficherUsage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	// sans position donnée, les issues restent au milieu des bordures
+	if (!issuesDonnees)
+	{
+		xIssues = largeurPlateau / 2;
+		yIssues = hauteurPlateau / 2;
+	}
+	struct stat etatCache;
+	if (repertoireCache != NULL && (stat(repertoireCache, &etatCache) != 0 || !S_ISDIR(etatCache.st_mode)))
+	{
+		fprintf(stderr, "%s : répertoire du cache introuvable\n", repertoireCache);
+		return EXIT_FAILURE;
+	}
+	if (nbParties <= 0 || nbThreads <= 0 || strategie1 < 0 || strategie2 < 0 ||
+	    nbSerpents < 2 || nbSerpents > NB_SERPENTS_MAX || nbPlanificateurs <= 0 ||
+	    croissance < 0 || croissance > CROISSANCE_MAX || budgetMcts <= 0 || nbThreadsMcts <= 0 ||
+	    budgetAlphaBeta <= 0 ||
+	    largeurPlateau < LARGEUR_MIN || largeurPlateau > DIMENSION_MAX ||
+	    hauteurPlateau < HAUTEUR_MIN || hauteurPlateau > DIMENSION_MAX ||
+	    xIssues < 2 || xIssues >= largeurPlateau || yIssues < 2 || yIssues >= hauteurPlateau ||
+	    taillePaves < 1 || taillePaves > hauteurPlateau / 3)
+	{
+		afficherUsage(argv[0]);
+		return EXIT_FAILURE;
+	}
+	// les parties aux pavés tirés au hasard doivent pouvoir placer leurs pavés
+	int xPave, yPave;
+	if (!premierePositionPave(&xPave, &yPave))
+	{
+		fprintf(stderr, "Aucune place pour des pavés de %d cases sur un plateau de %d x %d cases\n",
+			taillePaves, largeurPlateau, hauteurPlateau);
+		return EXIT_FAILURE;
+	}
 
+	// contexte de la partie jouée dans le processus principal
+	// (sert aussi de modèle aux parties du mode tournoi)
+	tPartie *partie = malloc(sizeof(tPartie));
+	if (partie == NULL)
+	{
+		perror("malloc");
+		return EXIT_FAILURE;
+	}
+	initPartie(partie, nbSerpents);
+	partie->serpents[0].strategie = strategie1;
+	for (int i = 1 ; i < nbSerpents ; i++)
+	{
+		partie->serpents[i].strategie = strategie2;
+	}
+	partie->nbPlanificateurs = nbPlanificateurs;
+	partie->periode = periode;
+	partie->mesurerLatences = latences;
+	partie->croissance = croissance;
+	partie->budgetMcts = budgetMcts * 1000000;
+	partie->nbThreadsMcts = nbThreadsMcts;
+	partie->budgetAlphaBeta = budgetAlphaBeta * 1000000;
+	// la disposition par défaut des pommes et des pavés ne vaut que pour le plateau par défaut
+	if (largeurPlateau != LARGEUR_PLATEAU || hauteurPlateau != HAUTEUR_PLATEAU ||
+	    xIssues != LARGEUR_PLATEAU / 2 || yIssues != HAUTEUR_PLATEAU / 2 || taillePaves != TAILLE_PAVES)
+	{
+		genererPartieAleatoire(partie, GRAINE_TOURNOI);
+	}
 
-*************************************************/
-void initPlateau(tPlateau plateau, int lesX[], int lesY[])
-{
-	// initialisation du plateau avec des espaces
-	for (int i = 1 ; i <= LARGEUR_PLATEAU ; i++)
+	// mode simulation : les parties s'enchaînent sans affichage ni temporisation
+	if (mode == MODE_SIMULATION)
 	{
-		for (int j = 1 ; j <= HAUTEUR_PLATEAU ; j++)
+		struct timespec debut, fin;
+		long long totalDeplacements = 0;
+		clock_gettime(CLOCK_MONOTONIC, &debut);
+		for (int i = 0 ; i < nbParties ; i++)
+		{
+			totalDeplacements += jouerPartie(partie);
+		}
+		clock_gettime(CLOCK_MONOTONIC, &fin);
+
+		double duree = (fin.tv_sec - debut.tv_sec) + (fin.tv_nsec - debut.tv_nsec) / 1e9;
+		printf("%d parties, %lld tours en %.3f s : %.0f tours/s\n",
+			nbParties, totalDeplacements, duree, (duree > 0) ? totalDeplacements / duree : 0.0);
+		printf("Dernière partie - Serpent 1 : %d déplacements et %d pommes mangées\n", partie->serpents[0].deplacements, partie->serpents[0].nbPommes);
+		printf("Dernière partie - Serpent 2 : %d déplacements et %d pommes mangées\n", partie->serpents[1].deplacements, partie->serpents[1].nbPommes);
+		if (nbSerpents > 2)
+		{
+			printf("Dernière partie - %d serpents encore en jeu sur %d\n", partie->nbVivants, nbSerpents);
+		}
+		if (latences)
 		{
-			plateau[i][j] = VIDE;
+			afficherLatences(stdout, partie);
+			if (fichierLatences != NULL)
+			{
+				ecrireLatences(fichierLatences, partie);
+			}
 		}
+		libererPartie(partie);
+		free(partie);
+		return EXIT_SUCCESS;
 	}
-	// Mise en place la bordure autour du plateau
-	// première ligne
-	for (int i = 1 ; i <= LARGEUR_PLATEAU ; i++)
+
+	// mode banc d'essai : coût des fonctions du moteur, appel par appel
+	if (mode == MODE_BANC)
 	{
-		plateau[i][1] = BORDURE;
-		plateau[LARGEUR_PLATEAU / 2][1] = VIDE; // trou du haut
+		jouerBancEssai(partie);
+		libererPartie(partie);
+		free(partie);
+		return EXIT_SUCCESS;
 	}
-	// lignes intermédiaires
-	for (int j = 1 ; j <= HAUTEUR_PLATEAU ; j++)
+
+	// mode tournoi : parties aléatoires réparties sur plusieurs threads
+	if (mode == MODE_TOURNOI)
 	{
-		plateau[1][j] = BORDURE;
-		plateau[1][HAUTEUR_PLATEAU / 2] = VIDE; // trou de gauche
-		plateau[LARGEUR_PLATEAU][j] = BORDURE;
-		plateau[LARGEUR_PLATEAU][HAUTEUR_PLATEAU / 2] = VIDE; // trou de droite
+		tBilanTournoi bilan;
+		struct timespec debut, fin;
+		clock_gettime(CLOCK_MONOTONIC, &debut);
+		jouerTournoi(partie, nbParties, nbThreads, &bilan);
+		clock_gettime(CLOCK_MONOTONIC, &fin);
+
+		afficherBilanTournoi(partie, &bilan);
+		printf("Durée : %.3f s sur %d threads\n",
+			(fin.tv_sec - debut.tv_sec) + (fin.tv_nsec - debut.tv_nsec) / 1e9, nbThreads);
+		libererPartie(partie);
+		free(partie);
+		return EXIT_SUCCESS;
 	}
-	// dernière ligne
-	for (int i = 1 ; i <= LARGEUR_PLATEAU ; i++)
+
+	// en mode affichage, les durées des phases sont toujours mesurées
+	// (quelques dizaines de nanosecondes par tour, rien au regard de la cadence)
+	partie->affichage = true;
+	partie->mesurerLatences = true;
+	jouerPartie(partie);
+	gotoxy(1, partie->hauteurVue + 1);
+
+	// afficher les performances du programme
+	printf("Serpent 1 : %d déplacements et %d pommes mangées\n", partie->serpents[0].deplacements, partie->serpents[0].nbPommes);
+	printf("Serpent 2 : %d déplacements et %d pommes mangées\n", partie->serpents[1].deplacements, partie->serpents[1].nbPommes);
+	printf("Tours en retard sur la cadence de %.1f ms : %d\n", partie->periode / 1e6, partie->toursEnRetard);
+	afficherLatences(stdout, partie);
+	if (fichierLatences != NULL)
 	{
-		plateau[i][HAUTEUR_PLATEAU] = BORDURE;
-		plateau[LARGEUR_PLATEAU / 2][HAUTEUR_PLATEAU] = VIDE; // trou du bas
+		ecrireLatences(fichierLatences, partie);
 	}
-	//  place les pavés sur le plateau
-    placerPaves(plateau);
+
+	libererPartie(partie);
+	free(partie);
+	return EXIT_SUCCESS;
 }
 
-void placerPaves(tPlateau plateau) {
-    for (int i = 0; i < NB_PAVES; i++) {
-        for (int x = lesPavesX[i]; x < lesPavesX[i] + TAILLE_PAVES; x++) {
-            for (int y = lesPavesY[i]; y < lesPavesY[i] + TAILLE_PAVES; y++) {
-                // Vérifier si x et y sont dans les limites du plateau
-                if (x >= 1 && x <= LARGEUR_PLATEAU && y >= 1 && y <= HAUTEUR_PLATEAU) {
-                    plateau[x][y] = BORDURE;
-                }
-            }
-        }
-    }
+void afficherUsage(const char *programme)
+{
+	fprintf(stderr, "Usage : %s [--simulation [nombre de parties] | --tournoi <nombre de parties> [nombre de threads] | --banc]\n", programme);
+	fprintf(stderr, "          [--strategie1 <nom>] [--strategie2 <nom>] [--vitesse <multiplicateur>]\n");
+	fprintf(stderr, "          [--serpents <nombre>] (de 2 à %d, les serpents suivants jouent la stratégie 2)\n", NB_SERPENTS_MAX);
+	fprintf(stderr, "          [--planificateurs <nombre de threads>] [--latences [fichier]]\n");
+	fprintf(stderr, "          [--croissance <anneaux par pomme>] (de 0 à %d)\n", CROISSANCE_MAX);
+	fprintf(stderr, "          [--budget-mcts <millisecondes par tour>] [--threads-mcts <nombre>]\n");
+	fprintf(stderr, "          [--budget-alphabeta <millisecondes par tour>] [--cache <répertoire>]\n");
+	fprintf(stderr, "          [--plateau <largeur> <hauteur>] [--issues <colonne> <ligne>] [--paves <taille>]\n");
+	fprintf(stderr, "Plateau de %d x %d à %d x %d cases, pavés d'au plus un tiers de la hauteur\n",
+		LARGEUR_MIN, HAUTEUR_MIN, DIMENSION_MAX, DIMENSION_MAX);
+	fprintf(stderr, "Stratégies :");
+	for (int i = 0 ; i < NB_STRATEGIES ; i++)
+	{
+		fprintf(stderr, " %s", NOMS_STRATEGIES[i]);
+	}
+	fprintf(stderr, "\n");
 }
 
-void dessinerPlateau(tPlateau plateau)
+int lireStrategie(const char *nom)
 {
-	int i, j;
-	// affiche à l'écran le contenu du tableau 2D représentant le plateau
-	for (i = 1 ; i <= LARGEUR_PLATEAU ; i++)
+	// retourne le numéro de la stratégie dont le nom est donné, -1 si elle n'existe pas
+	for (int i = 0 ; i < NB_STRATEGIES ; i++)
 	{
-		for (j = 1 ; j <= HAUTEUR_PLATEAU ; j++)
+		if (strcmp(nom, NOMS_STRATEGIES[i]) == 0)
 		{
-			afficher(i, j, plateau[i][j]);
+			return i;
 		}
 	}
+	return -1;
 }
 
-void ajouterPomme(tPlateau plateau, int iPomme)
+void initPartie(tPartie *partie, int nbSerpents)
 {
-	// génère aléatoirement la position d'une pomme,
-	// vérifie que ça correspond à une case vide
-	// du plateau puis l'ajoute au plateau et l'affiche
-	int xPomme, yPomme;
-	do
+	// disposition des pommes et des pavés par défaut, sans affichage
+	memcpy(partie->lesPommesX, POMMES_X, sizeof(POMMES_X));
+	memcpy(partie->lesPommesY, POMMES_Y, sizeof(POMMES_Y));
+	memcpy(partie->lesPavesX, PAVES_X, sizeof(PAVES_X));
+	memcpy(partie->lesPavesY, PAVES_Y, sizeof(PAVES_Y));
+	partie->affichage = false;
+	partie->periode = (long)ATTENTE * 1000;
+	partie->croissance = 0;
+	// serpents mis à zéro (recherches D* Lite comprises, corps alloués par preparerPartie),
+	// tous sur la stratégie par défaut
+	partie->nbSerpents = nbSerpents;
+	partie->serpents = allouerMemoire(nbSerpents * sizeof(tSerpent));
+	for (int i = 0 ; i < nbSerpents ; i++)
 	{
-		xPomme = lesPommesX[iPomme];
-		yPomme = lesPommesY[iPomme];
-	} while (plateau[xPomme][yPomme] != ' ');
-	plateau[xPomme][yPomme] = POMME;
-	afficher(xPomme, yPomme, POMME);
+		partie->serpents[i].strategie = STRATEGIE_CHAMP;
+	}
+	partie->nbVivants = nbSerpents;
+	// sans thread auxiliaire de planification tant qu'on n'en demande pas
+	partie->nbPlanificateurs = 1;
+	memset(&partie->planificateurs, 0, sizeof(partie->planificateurs));
+	// recherche mcts sur le seul thread de la partie, threads créés à la première utilisation
+	partie->budgetMcts = (long)BUDGET_MCTS * 1000000;
+	partie->nbThreadsMcts = 1;
+	memset(&partie->mcts, 0, sizeof(partie->mcts));
+	// table de transposition et état du duel alloués à la première recherche alpha-bêta
+	partie->budgetAlphaBeta = (long)BUDGET_ALPHABETA * 1000000;
+	memset(&partie->alphaBeta, 0, sizeof(partie->alphaBeta));
+	pthread_mutex_init(&partie->alphaBeta.recherche, NULL);
+	// latences non mesurées, histogrammes vides
+	partie->mesurerLatences = false;
+	memset(partie->latences, 0, sizeof(partie->latences));
+	// tableaux d'une valeur par case, aux dimensions du plateau
+	partie->plateau = allouerMemoire(NB_CASES);
+	partie->occupation = allouerMemoire(NB_CASES);
+	partie->annonces = allouerMemoire(NB_CASES);
+	creerBitboard(&partie->murs);
+	creerBitboard(&partie->paves);
+	creerBitboard(&partie->corps);
+	creerBitboard(&partie->queues);
+	creerBitboard(&partie->reservees);
+	creerBitboard(&partie->colonneGauche);
+	creerBitboard(&partie->colonneDroite);
+	partie->casesModifiees = NULL;
+	partie->nbCasesModifiees = 0;
+	partie->capaciteCasesModifiees = 0;
+	// la mémoire propre à chaque stratégie n'est allouée qu'à sa première utilisation
+	partie->distancesPomme = NULL;
+	partie->fileChamp = NULL;
+	partie->rangCycle = NULL;
+	partie->casesCycle = NULL;
+	partie->longueurCycle = 0;
+	partie->cycleCalcule = false;
+	partie->projectionCycle = NULL;
+	partie->projectionDistances = NULL;
+	partie->distancesPaires = NULL;
+	partie->indiceLibre = NULL;
+	partie->nbLibres = 0;
+	partie->distancesCalculees = false;
+	memset(&partie->hpa, 0, sizeof(partie->hpa));
+	memset(&partie->aEtoile, 0, sizeof(partie->aEtoile));
+	partie->nbPommes = 0;
+	partie->nbTours = 0;
+	partie->vainqueur = EGALITE;
 }
 
-void afficher(int x, int y, char car)
+void libererPartie(tPartie *partie)
 {
-	gotoxy(x, y);
-	printf("%c", car);
-	gotoxy(1, 1);
+	// arrête les threads de planification et ceux de la stratégie mcts, puis libère
+	// la mémoire allouée par initPartie et par les stratégies
+	arreterPlanificateurs(partie);
+	arreterMcts(partie);
+	free(partie->plateau);
+	free(partie->occupation);
+	free(partie->annonces);
+	free(partie->casesModifiees);
+	libererBitboard(&partie->murs);
+	libererBitboard(&partie->paves);
+	libererBitboard(&partie->corps);
+	libererBitboard(&partie->queues);
+	libererBitboard(&partie->reservees);
+	libererBitboard(&partie->colonneGauche);
+	libererBitboard(&partie->colonneDroite);
+	free(partie->distancesPomme);
+	free(partie->fileChamp);
+	libererCycle(partie);
+	libererDistances(partie);
+	libererHpa(&partie->hpa);
+	free(partie->alphaBeta.table);
+	free(partie->alphaBeta.occupation);
+	free(partie->alphaBeta.serpents[0].cases);
+	free(partie->alphaBeta.serpents[1].cases);
+	pthread_mutex_destroy(&partie->alphaBeta.recherche);
+	libererAEtoile(&partie->aEtoile);
+	for (int i = 0 ; i < partie->nbSerpents ; i++)
+	{
+		tDStar *dStar = &partie->serpents[i].dStar;
+		free(partie->serpents[i].lesX);
+		free(partie->serpents[i].lesY);
+		free(dStar->g);
+		free(dStar->rhs);
+		free(dStar->bloquee);
+		free(dStar->cle1);
+		free(dStar->cle2);
+		free(dStar->place);
+		free(dStar->tas);
+	}
+	free(partie->serpents);
 }
 
-void effacer(int x, int y)
+void *allouerMemoire(size_t taille)
 {
-	gotoxy(x, y);
-	printf(" ");
-	gotoxy(1, 1);
+	// allocation d'une zone mise à zéro, le programme s'arrête si la mémoire manque
+	void *zone = calloc(1, taille);
+	if (zone == NULL)
+	{
+		perror("calloc");
+		exit(EXIT_FAILURE);
+	}
+	return zone;
 }
 
-/************************************************
-	   FONCTIONS ET PROCEDURES DU SERPENT 1	    
-*************************************************/
-void dessinerSerpent1(int lesX1[], int lesY1[])
+// Joue une partie complète et retourne le nombre de tours joués
+int jouerPartie(tPartie *partie)
 {
-	int i;
-	// affiche les anneaux puis la tête
-	for(i = 1 ; i < TAILLE ; i++)
+	// représente la touche frappée par l'utilisateur attend la possible entrée de la touche arrêt
+	char touche = 0;
+	// réglages du terminal à rétablir en fin de partie
+	struct termios terminalInitial;
+	// instant (horloge CLOCK_MONOTONIC) où le tour en cours doit se terminer
+	struct timespec echeance;
+	// début et fin de la phase d'affichage, fin de l'attente du clavier, pour les latences
+	struct timespec debut, fin;
+
+	//variables utiles aux interactions des serpents avec le pateau
+	bool gagne = false;
+
+	// mise en place du plateau, des serpents et de la première pomme
+	preparerPartie(partie);
+	if (partie->affichage)
 	{
-		afficher(lesX1[i], lesY1[i], CORPS);
+		system("clear");
+		// le terminal vient d'être vidé : l'image et l'écran ne contiennent que des espaces
+		memset(partie->image, ' ', sizeof(partie->image));
+		memset(partie->ecran, ' ', sizeof(partie->ecran));
+		partie->largeurVue = (largeurPlateau < LARGEUR_VUE) ? largeurPlateau : LARGEUR_VUE;
+		partie->hauteurVue = (hauteurPlateau < HAUTEUR_VUE) ? hauteurPlateau : HAUTEUR_VUE;
+		partie->xVue = 0;
+		partie->yVue = 0;
+		placerVue(partie, X_INITIAL, Y_INITIAL_SERPENT_1);
+	}
+	for (int i = 0 ; i < partie->nbSerpents ; i++)
+	{
+		dessinerSerpent(partie, i);
+	}
+	rafraichirEcran(partie);
+	if (partie->affichage)
+	{
+		activerModeBrut(&terminalInitial);
 	}
-	afficher(lesX1[0], lesY1[0], TETE_SERPENT_1);
-}
 
-void directionSerpent1(int lesX1[], int lesY1[], tPlateau plateau, char *direction1, int x, int y, int lesX2[], int lesY2[], char directionSerpent2)
-{
-	// Calcul des directions possibles
-	int differenceX = x - lesX1[0]; // Différence en X
-	int differenceY = y - lesY1[0]; // Différence en Y
+	// les échéances des tours sont fixées à partir de maintenant, une période après l'autre
+	clock_gettime(CLOCK_MONOTONIC, &echeance);
+	avancerEcheance(&echeance, partie->periode);
 
-	// Essayer de se déplacer dans la direction verticale
-	if (differenceY != 0)
+	// boucle de jeu des serpents. Arret si touche STOP, s'il reste moins de deux serpents
+	// en jeu ou si toutes les pommes sont mangées
+	do
 	{
-		*direction1 = (differenceY > 0) ? BAS : HAUT;
-		if (verifierCollisionProchainDeplacement1(lesX1, lesY1, plateau, *direction1, lesX2, lesY2, directionSerpent2))
+		gagne = jouerTour(partie);
+
+		// une seule écriture sur le terminal par tour, pour toutes les cases modifiées
+		// (la fenêtre est d'abord recentrée si la tête du serpent 1 s'approche de son bord)
+		if (partie->affichage)
 		{
-			// Si collision, essayer la direction horizontale
-			*direction1 = (differenceX > 0) ? DROITE : GAUCHE;
-			if (verifierCollisionProchainDeplacement1(lesX1, lesY1, plateau, *direction1, lesX2, lesY2, directionSerpent2))
+			if (partie->mesurerLatences)
 			{
-				// Si collision, essayer l'autre direction horizontale
-				*direction1 = (differenceX > 0) ? GAUCHE : DROITE;
-				if (verifierCollisionProchainDeplacement1(lesX1, lesY1, plateau, *direction1, lesX2, lesY2, directionSerpent2))
-				{
-					// Si collision, essayer l'autre direction verticale
-					*direction1 = (differenceY > 0) ? HAUT : BAS;
-				}
+				clock_gettime(CLOCK_MONOTONIC, &debut);
+			}
+			placerVue(partie, partie->serpents[0].lesX[partie->serpents[0].tete], partie->serpents[0].lesY[partie->serpents[0].tete]);
+			rafraichirEcran(partie);
+			if (partie->mesurerLatences)
+			{
+				clock_gettime(CLOCK_MONOTONIC, &fin);
+				enregistrerDuree(&partie->latences[PHASE_AFFICHAGE], ecartNs(&debut, &fin));
 			}
 		}
-	}
-	
-	// Si pas de déplacement horizontal possible, essayer horizontale
-	else if (differenceX != 0)
-	{
-		*direction1 = (differenceX > 0) ? DROITE : GAUCHE;
-		if (verifierCollisionProchainDeplacement1(lesX1, lesY1, plateau, *direction1, lesX2, lesY2, directionSerpent2))
+
+		if (!gagne && partie->affichage && partie->nbVivants >= 2)
 		{
-			// Si collision, essayer la direction verticale
-			*direction1 = (differenceY > 0) ? BAS : HAUT;
-			if (verifierCollisionProchainDeplacement1(lesX1, lesY1, plateau, *direction1, lesX2, lesY2, directionSerpent2))
+			// attente de la fin du tour, interrompue dès l'appui sur la touche d'arrêt ;
+			// seul le retard du réveil sur l'échéance visée est mesuré (l'attente elle-même
+			// n'est pas une latence) : l'échéance visée est la nouvelle moins une période
+			touche = attendreFinTour(partie, &echeance);
+			if (partie->mesurerLatences && touche != STOP)
 			{
-				// Si collision, essayer l'autre direction verticale
-				*direction1 = (differenceY > 0) ? HAUT : BAS;
-				if (verifierCollisionProchainDeplacement1(lesX1, lesY1, plateau, *direction1, lesX2, lesY2, directionSerpent2))
-				{
-					// Si collision, essayer l'autre direction horizontale
-					*direction1 = (differenceX > 0) ? GAUCHE : DROITE;
-				}
+				clock_gettime(CLOCK_MONOTONIC, &fin);
+				enregistrerDuree(&partie->latences[PHASE_CLAVIER], ecartNs(&echeance, &fin) + partie->periode);
 			}
 		}
-	}
-}
-
-int calculDistance1(int lesX1[], int lesY1[], int pommeX, int pommeY)
-{
-    // définition des variables
-    int passageTrouGauche, passageTrouDroit, passageTrouHaut, passageTrouBas, passageDirect;
+	} while (touche != STOP && partie->nbVivants >= 2 && !gagne &&
+		!(!partie->affichage && partie->nbTours >= LIMITE_DEPLACEMENTS));
 
-    // Calcul des distances
-    passageTrouGauche = abs(lesX1[0] - ISSUE_GAUCHE_X) + abs(lesY1[0] - ISSUE_GAUCHE_Y) + 
-        abs(pommeX - ISSUE_DROITE_X) + abs(pommeY - ISSUE_DROITE_Y);
-    passageTrouDroit = abs(lesX1[0] - ISSUE_DROITE_X) + abs(lesY1[0] - ISSUE_DROITE_Y) + 
-        abs(pommeX - ISSUE_GAUCHE_X) + abs(pommeY - ISSUE_GAUCHE_Y);
-    passageTrouHaut = abs(lesX1[0] - ISSUE_HAUT_X) + abs(lesY1[0] - ISSUE_HAUT_Y) + 
-        abs(pommeX - ISSUE_BAS_X) + abs(pommeY - ISSUE_BAS_Y);
-    passageTrouBas = abs(lesX1[0] - ISSUE_BAS_X) + abs(lesY1[0] - ISSUE_BAS_Y) + 
-        abs(pommeX - ISSUE_HAUT_X) + abs(pommeY - ISSUE_HAUT_Y);
-    passageDirect = abs(lesX1[0] - pommeX) + abs(lesY1[0] - pommeY);
+	if (partie->affichage)
+	{
+		restaurerTerminal(&terminalInitial);
+	}
 
-    // compare les résultats pour obtenir le meilleur chemin
-    // chemin direct vers la pomme sans passer dans un trou
-    if (passageDirect <= passageTrouHaut && passageDirect <= passageTrouBas &&
-        passageDirect <= passageTrouGauche && passageDirect <= passageTrouDroit)
-    {
-        return CHEMIN_POMME;
-    }
-    // Privilégie d'abord les passages verticaux
-    else if (passageTrouHaut <= passageTrouBas)
+	// parmi les serpents restés en jeu, celui qui a mangé le plus de pommes gagne
+	// (égalité si plusieurs en ont mangé autant, ou s'il n'en reste aucun)
+	int meilleurScore = -1;
+	partie->vainqueur = EGALITE;
+	for (int i = 0 ; i < partie->nbSerpents ; i++)
+	{
+		if (partie->serpents[i].collision)
+		{
+			continue;
+		}
+		if (partie->serpents[i].nbPommes > meilleurScore)
+		{
+			meilleurScore = partie->serpents[i].nbPommes;
+			partie->vainqueur = i + 1;
+		}
+		else if (partie->serpents[i].nbPommes == meilleurScore)
+		{
+			partie->vainqueur = EGALITE;
+		}
+	}
+
+	return partie->nbTours;
+}
+
+void preparerPartie(tPartie *partie)
+{
+	// remise à zéro des serpents et des compteurs (plusieurs parties peuvent se suivre
+	// sur le même contexte) ; les recherches incrémentales de la partie précédente
+	// ne sont plus valables ; le corps de chaque serpent est alloué ici, une fois pour toutes,
+	// à la plus grande longueur possible (TAILLE, plus la croissance de toutes les pommes,
+	// sans dépasser le nombre de cases du plateau)
+	int capacite = TAILLE + partie->croissance * NB_POMMES;
+	if ((size_t)capacite > NB_CASES)
+	{
+		capacite = (int)NB_CASES;
+	}
+	for (int i = 0 ; i < partie->nbSerpents ; i++)
+	{
+		tSerpent *serpent = &partie->serpents[i];
+		if (serpent->capacite != capacite)
+		{
+			free(serpent->lesX);
+			free(serpent->lesY);
+			serpent->lesX = allouerMemoire(capacite * sizeof(int));
+			serpent->lesY = allouerMemoire(capacite * sizeof(int));
+			serpent->capacite = capacite;
+		}
+		serpent->collision = false;
+		serpent->retire = false;
+		serpent->pommeMangee = false;
+		serpent->nbPommes = 0;
+		serpent->deplacements = 0;
+		serpent->dStar.initialise = false;
+	}
+	partie->nbVivants = partie->nbSerpents;
+	partie->nbPommes = 0;
+	partie->nbTours = 0;
+	partie->toursEnRetard = 0;
+
+	// mise en place du plateau
+	initPlateau(partie);
+	// cycle hamiltonien de la carte, avant que les serpents n'occupent le plateau
+	preparerCycle(partie);
+	// distances entre toutes les cases libres de la carte, pour les stratégies qui les interrogent
+	preparerDistances(partie);
+	// graphe abstrait de la carte pour la recherche hiérarchique de la stratégie heuristique
+	preparerGrapheHpa(partie);
+	// threads et états de simulation de la stratégie mcts, à la première partie qui la joue
+	if (partie->mcts.travaux == NULL)
+	{
+		for (int i = 0 ; i < partie->nbSerpents ; i++)
+		{
+			if (partie->serpents[i].strategie == STRATEGIE_MCTS)
+			{
+				demarrerMcts(partie);
+				break;
+			}
+		}
+	}
+	// les serpents sont posés sur le plateau avant la première pomme,
+	// pour qu'elle ne soit pas placée sous l'un d'eux
+	viderBitboard(&partie->corps);
+	viderBitboard(&partie->queues);
+	memset(partie->occupation, 0, NB_CASES);
+	partie->nbCasesModifiees = 0;
+	placerSerpents(partie);
+	ajouterPomme(partie, partie->nbPommes);
+}
+
+bool jouerTour(tPartie *partie)
+{
+	// joue un tour complet (choix des directions, déplacements, éliminations, pommes),
+	// sans affichage du plateau ni attente ; retourne vrai quand toutes les pommes sont mangées
+	bool gagne = false;
+	struct timespec debut, planifie, fin;
+
+	/* choix de la direction de chaque serpent selon sa stratégie */
+	if (partie->mesurerLatences)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &debut);
+	}
+	planifierTour(partie);
+	if (partie->mesurerLatences)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &planifie);
+	}
+
+	// deplacement de chaque serpent encore en jeu, dans l'ordre des numéros,
+	// et incrémentation de son compteur de déplacements
+	partie->nbCasesModifiees = 0;
+	for (int i = 0 ; i < partie->nbSerpents ; i++)
+	{
+		tSerpent *serpent = &partie->serpents[i];
+		if (!serpent->collision)
+		{
+			progresser(partie, i);
+			serpent->deplacements++;
+			if (serpent->collision)
+			{
+				partie->nbVivants--;
+			}
+		}
+	}
+	partie->nbTours++;
+
+	// les serpents éliminés à ce tour quittent le plateau si la partie continue sans eux
+	if (partie->nbVivants >= 2)
+	{
+		for (int i = 0 ; i < partie->nbSerpents ; i++)
+		{
+			if (partie->serpents[i].collision && !partie->serpents[i].retire)
+			{
+				retirerSerpent(partie, i);
+			}
+		}
+	}
+
+	// Ajoute une pomme au compteur de pomme quand elle est mangée et arrete le jeu si score atteint 10
+	// (une seule pomme est sur le plateau, un seul serpent peut l'avoir mangée)
+	for (int i = 0 ; i < partie->nbSerpents ; i++)
+	{
+		tSerpent *serpent = &partie->serpents[i];
+		if (!serpent->pommeMangee)
+		{
+			continue;
+		}
+		serpent->pommeMangee = false;
+		serpent->nbPommes++;
+		partie->nbPommes++;
+		if (partie->croissance > 0 && !serpent->collision)
+		{
+			// le serpent s'allonge pendant ses prochains déplacements : sa queue ne bouge plus
+			int queue = indiceQueue(serpent);
+			serpent->aGrandir += partie->croissance;
+			desactiverBit(&partie->queues, serpent->lesX[queue], serpent->lesY[queue]);
+		}
+		if (partie->nbPommes == NB_POMMES)
+		{
+			gagne = true;
+		}
+		else
+		{
+			ajouterPomme(partie, partie->nbPommes);
+		}
+	}
+
+	if (partie->mesurerLatences)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &fin);
+		enregistrerDuree(&partie->latences[PHASE_PLANIFICATION], ecartNs(&debut, &planifie));
+		enregistrerDuree(&partie->latences[PHASE_MISE_A_JOUR], ecartNs(&planifie, &fin));
+	}
+	return gagne;
+}
+
+
+/************************************************
+		FONCTIONS ET PROCEDURES DU CODE 	   
+
+
+*************************************************/
+int indiceQueue(const tSerpent *serpent)
+{
+    // indice de la queue du serpent dans son tableau circulaire
+    return (serpent->tete + serpent->longueur - 1) % serpent->capacite;
+}
+
+void initPlateau(tPartie *partie)
+{
+	// initialisation du plateau avec des espaces
+	for (int i = 1 ; i <= largeurPlateau ; i++)
+	{
+		for (int j = 1 ; j <= hauteurPlateau ; j++)
+		{
+			partie->plateau[CASE(i, j)] = VIDE;
+		}
+	}
+	// Mise en place la bordure autour du plateau
+	// première ligne
+	for (int i = 1 ; i <= largeurPlateau ; i++)
+	{
+		partie->plateau[CASE(i, 1)] = BORDURE;
+		partie->plateau[CASE(xIssues, 1)] = VIDE; // trou du haut
+	}
+	// lignes intermédiaires
+	for (int j = 1 ; j <= hauteurPlateau ; j++)
+	{
+		partie->plateau[CASE(1, j)] = BORDURE;
+		partie->plateau[CASE(1, yIssues)] = VIDE; // trou de gauche
+		partie->plateau[CASE(largeurPlateau, j)] = BORDURE;
+		partie->plateau[CASE(largeurPlateau, yIssues)] = VIDE; // trou de droite
+	}
+	// dernière ligne
+	for (int i = 1 ; i <= largeurPlateau ; i++)
+	{
+		partie->plateau[CASE(i, hauteurPlateau)] = BORDURE;
+		partie->plateau[CASE(xIssues, hauteurPlateau)] = VIDE; // trou du bas
+	}
+	// version bit à bit des bordures, et masques des colonnes extrêmes
+	viderBitboard(&partie->murs);
+	viderBitboard(&partie->colonneGauche);
+	viderBitboard(&partie->colonneDroite);
+	for (int j = 1 ; j <= hauteurPlateau ; j++)
+	{
+		activerBit(&partie->colonneGauche, 1, j);
+		activerBit(&partie->colonneDroite, largeurPlateau, j);
+	}
+	for (int i = 1 ; i <= largeurPlateau ; i++)
+	{
+		for (int j = 1 ; j <= hauteurPlateau ; j++)
+		{
+			if (partie->plateau[CASE(i, j)] == BORDURE)
+			{
+				activerBit(&partie->murs, i, j);
+			}
+		}
+	}
+	//  place les pavés sur le plateau
+    placerPaves(partie);
+}
+
+void placerPaves(tPartie *partie) {
+    viderBitboard(&partie->paves);
+    for (int i = 0; i < NB_PAVES; i++) {
+        for (int x = partie->lesPavesX[i]; x < partie->lesPavesX[i] + taillePaves; x++) {
+            for (int y = partie->lesPavesY[i]; y < partie->lesPavesY[i] + taillePaves; y++) {
+                // Vérifier si x et y sont dans les limites du plateau
+                if (x >= 1 && x <= largeurPlateau && y >= 1 && y <= hauteurPlateau) {
+                    partie->plateau[CASE(x, y)] = BORDURE;
+                    activerBit(&partie->paves, x, y);
+                }
+            }
+        }
+    }
+}
+
+void dessinerPlateau(tPartie *partie)
+{
+	int i, j;
+	// affiche à l'écran le contenu du plateau visible dans la fenêtre
+	for (j = partie->yVue ; j < partie->yVue + partie->hauteurVue ; j++)
+	{
+		for (i = partie->xVue ; i < partie->xVue + partie->largeurVue ; i++)
+		{
+			afficher(partie, i, j, partie->plateau[CASE(i, j)]);
+		}
+	}
+}
+
+void placerVue(tPartie *partie, int x, int y)
+{
+	// recentre la fenêtre sur la case (x, y) quand elle est à moins de MARGE_VUE cases
+	// de son bord (sans sortir du plateau) et la redessine si elle a bougé
+	int xVue = partie->xVue, yVue = partie->yVue;
+	if (x < xVue + MARGE_VUE || x >= xVue + partie->largeurVue - MARGE_VUE)
+	{
+		xVue = x - partie->largeurVue / 2;
+	}
+	if (y < yVue + MARGE_VUE || y >= yVue + partie->hauteurVue - MARGE_VUE)
+	{
+		yVue = y - partie->hauteurVue / 2;
+	}
+	xVue = (xVue > largeurPlateau - partie->largeurVue + 1) ? largeurPlateau - partie->largeurVue + 1 : xVue;
+	yVue = (yVue > hauteurPlateau - partie->hauteurVue + 1) ? hauteurPlateau - partie->hauteurVue + 1 : yVue;
+	xVue = (xVue < 1) ? 1 : xVue;
+	yVue = (yVue < 1) ? 1 : yVue;
+	if (xVue != partie->xVue || yVue != partie->yVue)
+	{
+		partie->xVue = xVue;
+		partie->yVue = yVue;
+		dessinerPlateau(partie);
+	}
+}
+
+void ajouterPomme(tPartie *partie, int iPomme)
+{
+	// génère aléatoirement la position d'une pomme,
+	// vérifie que ça correspond à une case vide
+	// du plateau puis l'ajoute au plateau et l'affiche
+	int xPomme, yPomme;
+	xPomme = partie->lesPommesX[iPomme];
+	yPomme = partie->lesPommesY[iPomme];
+	// si un serpent occupe la case prévue, la pomme est posée sur la case libre suivante
+	while (partie->plateau[CASE(xPomme, yPomme)] != VIDE)
+	{
+		xPomme++;
+		if (xPomme > largeurPlateau)
+		{
+			xPomme = 1;
+			yPomme = (yPomme % hauteurPlateau) + 1;
+		}
+	}
+	partie->plateau[CASE(xPomme, yPomme)] = POMME;
+	partie->xPomme = xPomme;
+	partie->yPomme = yPomme;
+	afficher(partie, xPomme, yPomme, POMME);
+
+	// le champ de distances de cette pomme et la route de la recherche hiérarchique
+	// seront calculés une seule fois, au premier tour où une stratégie en a besoin
+	partie->champAJour = false;
+	partie->hpa.routeAJour = false;
+}
+
+void afficher(tPartie *partie, int x, int y, char car)
+{
+	if (!partie->affichage)
+	{
+		return;
+	}
+	// le caractère n'est envoyé au terminal qu'au prochain rafraichirEcran,
+	// et seulement si la case est dans la fenêtre
+	if (x >= partie->xVue && x < partie->xVue + partie->largeurVue &&
+	    y >= partie->yVue && y < partie->yVue + partie->hauteurVue)
+	{
+		partie->image[y - partie->yVue + 1][x - partie->xVue + 1] = car;
+	}
+}
+
+void effacer(tPartie *partie, int x, int y)
+{
+	if (!partie->affichage)
+	{
+		return;
+	}
+	afficher(partie, x, y, ' ');
+}
+
+void rafraichirEcran(tPartie *partie)
+{
+	// envoie au terminal, en un seul appel à write, les cases dont le caractère a changé
+	// depuis le dernier rafraîchissement ; le curseur n'est déplacé que quand la case
+	// modifiée ne suit pas directement la précédente sur la même ligne
+	char tampon[TAILLE_TAMPON_ECRAN];
+	int taille = 0;
+	int xCurseur = 0, yCurseur = 0;
+
+	if (!partie->affichage)
+	{
+		return;
+	}
+	for (int j = 1 ; j <= partie->hauteurVue ; j++)
+	{
+		for (int i = 1 ; i <= partie->largeurVue ; i++)
+		{
+			if (partie->image[j][i] != partie->ecran[j][i])
+			{
+				if (i != xCurseur || j != yCurseur)
+				{
+					taille += sprintf(tampon + taille, "\033[%d;%df", j, i);
+				}
+				tampon[taille++] = partie->image[j][i];
+				partie->ecran[j][i] = partie->image[j][i];
+				xCurseur = i + 1;
+				yCurseur = j;
+			}
+		}
+	}
+	if (taille == 0)
+	{
+		return;
+	}
+	taille += sprintf(tampon + taille, "\033[1;1f");
+
+	// ce qui a été écrit par printf doit précéder l'image
+	fflush(stdout);
+	for (int envoye = 0 ; envoye < taille ; )
+	{
+		ssize_t n = write(STDOUT_FILENO, tampon + envoye, taille - envoye);
+		if (n <= 0)
+		{
+			break;
+		}
+		envoye += n;
+	}
+}
+
+/************************************************
+	   FONCTIONS DE CHOIX DE LA DIRECTION
+*************************************************/
+void planifierTour(tPartie *partie)
+{
+	// choix des directions en deux temps, pour un résultat qui ne dépend ni du nombre
+	// de threads ni de l'ordre dans lequel ils prennent les serpents :
+	// 1. chaque serpent choisit sa direction sur l'état du plateau en début de tour,
+	//    en évitant les cases où arriveront les autres s'ils gardent leur direction ;
+	//    ce choix ne modifie que le serpent lui-même et peut donc se faire en parallèle
+	// 2. les serpents sont départagés dans l'ordre de leur numéro : celui dont la tête vise
+	//    une case déjà retenue par un serpent de plus petit numéro prend la première de ses
+	//    directions de repli, classées au premier choix, qui évite cette case et si possible
+	//    celles visées par tous les autres (aucune recherche n'est refaite)
+	tPlanificateurs *planificateurs = &partie->planificateurs;
+
+	annoncerDeplacements(partie);
+	// le champ de distances sert aussi au classement des replis : il est calculé avant
+	// le premier choix, quel que soit le nombre de threads
+	preparerChamp(partie);
+	if (partie->nbPlanificateurs == 1)
+	{
+		planificateurs->suivant = 0;
+		planifierSerpents(partie, &partie->aEtoile);
+	}
+	else
+	{
+		if (planificateurs->threads == NULL)
+		{
+			demarrerPlanificateurs(partie);
+		}
+		// la route de la recherche hiérarchique est partagée :
+		// elle est calculée avant que les threads la lisent
+		preparerRouteHpa(partie);
+		pthread_mutex_lock(&planificateurs->verrou);
+		planificateurs->suivant = 0;
+		planificateurs->nbTermines = 0;
+		planificateurs->tour++;
+		pthread_cond_broadcast(&planificateurs->debut);
+		pthread_mutex_unlock(&planificateurs->verrou);
+
+		planifierSerpents(partie, &partie->aEtoile);
+
+		pthread_mutex_lock(&planificateurs->verrou);
+		while (planificateurs->nbTermines < planificateurs->nbThreads)
+		{
+			pthread_cond_wait(&planificateurs->fin, &planificateurs->verrou);
+		}
+		pthread_mutex_unlock(&planificateurs->verrou);
+	}
+
+	// résolution des conflits entre têtes qui visent la même case
+	retirerAnnonces(partie);
+	annoncerDeplacements(partie);
+	for (int i = 0 ; i < partie->nbSerpents ; i++)
+	{
+		tSerpent *serpent = &partie->serpents[i];
+		if (serpent->collision)
+		{
+			continue;
+		}
+		if (testerBit(&partie->reservees, CASE_X(serpent->annonce), CASE_Y(serpent->annonce)))
+		{
+			serpent->direction = directionRepli(partie, i);
+			corrigerAnnonce(partie, i);
+		}
+		activerBit(&partie->reservees, CASE_X(serpent->annonce), CASE_Y(serpent->annonce));
+	}
+	for (int i = 0 ; i < partie->nbSerpents ; i++)
+	{
+		if (!partie->serpents[i].collision)
+		{
+			desactiverBit(&partie->reservees, CASE_X(partie->serpents[i].annonce), CASE_Y(partie->serpents[i].annonce));
+		}
+	}
+	retirerAnnonces(partie);
+}
+
+void planifierSerpents(tPartie *partie, tAEtoile *aEtoile)
+{
+	// choisit la direction des serpents encore en jeu, TRANCHE_PLANIFICATION à la fois,
+	// jusqu'à ce que tous aient été pris par l'un des threads
+	int *suivant = &partie->planificateurs.suivant;
+	while (true)
+	{
+		int premier = __atomic_fetch_add(suivant, TRANCHE_PLANIFICATION, __ATOMIC_RELAXED);
+		if (premier >= partie->nbSerpents)
+		{
+			return;
+		}
+		for (int i = premier ; i < premier + TRANCHE_PLANIFICATION && i < partie->nbSerpents ; i++)
+		{
+			if (!partie->serpents[i].collision)
+			{
+				choisirDirection(partie, i, aEtoile);
+			}
+		}
+	}
+}
+
+void demarrerPlanificateurs(tPartie *partie)
+{
+	// crée les threads auxiliaires, qui attendent le premier tour à planifier
+	tPlanificateurs *planificateurs = &partie->planificateurs;
+	planificateurs->nbThreads = partie->nbPlanificateurs - 1;
+	planificateurs->threads = allouerMemoire(planificateurs->nbThreads * sizeof(pthread_t));
+	planificateurs->travaux = allouerMemoire(planificateurs->nbThreads * sizeof(tTravailPlanification));
+	planificateurs->tour = 0;
+	planificateurs->arret = false;
+	pthread_mutex_init(&planificateurs->verrou, NULL);
+	pthread_cond_init(&planificateurs->debut, NULL);
+	pthread_cond_init(&planificateurs->fin, NULL);
+	for (int t = 0 ; t < planificateurs->nbThreads ; t++)
+	{
+		planificateurs->travaux[t].partie = partie;
+		if (pthread_create(&planificateurs->threads[t], NULL, threadPlanificateur, &planificateurs->travaux[t]) != 0)
+		{
+			perror("pthread_create");
+			exit(EXIT_FAILURE);
+		}
+	}
+}
+
+void arreterPlanificateurs(tPartie *partie)
+{
+	// réveille les threads auxiliaires pour qu'ils se terminent, puis libère leur mémoire
+	tPlanificateurs *planificateurs = &partie->planificateurs;
+	if (planificateurs->threads == NULL)
+	{
+		return;
+	}
+	pthread_mutex_lock(&planificateurs->verrou);
+	planificateurs->arret = true;
+	pthread_cond_broadcast(&planificateurs->debut);
+	pthread_mutex_unlock(&planificateurs->verrou);
+	for (int t = 0 ; t < planificateurs->nbThreads ; t++)
+	{
+		pthread_join(planificateurs->threads[t], NULL);
+		libererAEtoile(&planificateurs->travaux[t].aEtoile);
+	}
+	pthread_mutex_destroy(&planificateurs->verrou);
+	pthread_cond_destroy(&planificateurs->debut);
+	pthread_cond_destroy(&planificateurs->fin);
+	free(planificateurs->threads);
+	free(planificateurs->travaux);
+	planificateurs->threads = NULL;
+}
+
+void *threadPlanificateur(void *arg)
+{
+	// à chaque nouveau tour, prend sa part des serpents puis signale qu'il a fini
+	tTravailPlanification *travail = arg;
+	tPlanificateurs *planificateurs = &travail->partie->planificateurs;
+	int tourTraite = 0;
+
+	while (true)
+	{
+		pthread_mutex_lock(&planificateurs->verrou);
+		while (!planificateurs->arret && planificateurs->tour == tourTraite)
+		{
+			pthread_cond_wait(&planificateurs->debut, &planificateurs->verrou);
+		}
+		if (planificateurs->arret)
+		{
+			pthread_mutex_unlock(&planificateurs->verrou);
+			return NULL;
+		}
+		tourTraite = planificateurs->tour;
+		pthread_mutex_unlock(&planificateurs->verrou);
+
+		planifierSerpents(travail->partie, &travail->aEtoile);
+
+		pthread_mutex_lock(&planificateurs->verrou);
+		if (++planificateurs->nbTermines == planificateurs->nbThreads)
+		{
+			pthread_cond_signal(&planificateurs->fin);
+		}
+		pthread_mutex_unlock(&planificateurs->verrou);
+	}
+}
+
+void preparerChamp(tPartie *partie)
+{
+	// calcule le champ de distances de la pomme courante s'il ne l'est pas encore
+	// et qu'une stratégie d'un des serpents en a besoin
+	if (partie->champAJour)
+	{
+		return;
+	}
+	for (int i = 0 ; i < partie->nbSerpents ; i++)
+	{
+		if (!partie->serpents[i].collision && partie->serpents[i].strategie != STRATEGIE_HEURISTIQUE)
+		{
+			calculerChampDistances(partie, partie->xPomme, partie->yPomme);
+			partie->champAJour = true;
+			return;
+		}
+	}
+}
+
+void choisirDirection(tPartie *partie, int numero, tAEtoile *aEtoile)
+{
+	tSerpent *serpent = &partie->serpents[numero];
+	int xCible, yCible;
+
+	// coût de chaque direction pour le classement des replis : distance de la case d'arrivée
+	// à la pomme d'après le champ de distances (la stratégie mcts le remplace par ses visites)
+	evaluerDirectionsChamp(partie, numero);
+
+	if (serpent->strategie == STRATEGIE_CHAMP)
+	{
+		serpent->direction = directionChamp(partie, numero);
+	}
+	else if (serpent->strategie == STRATEGIE_ASTAR)
+	{
+		serpent->direction = directionAEtoile(partie, numero, aEtoile);
+	}
+	else if (serpent->strategie == STRATEGIE_DSTAR)
+	{
+		serpent->direction = directionDStar(partie, numero, aEtoile);
+	}
+	else if (serpent->strategie == STRATEGIE_HAMILTON)
+	{
+		serpent->direction = directionHamilton(partie, numero, aEtoile);
+	}
+	else if (serpent->strategie == STRATEGIE_MCTS)
+	{
+		serpent->direction = directionMcts(partie, numero);
+	}
+	else if (serpent->strategie == STRATEGIE_ALPHABETA)
+	{
+		serpent->direction = directionAlphaBeta(partie, numero);
+	}
+	else
+	{
+		// stratégie heuristique : le serpent se dirige vers la case voisine par où passe
+		// le chemin de la recherche hiérarchique (ou vers son étape, s'il n'y a pas de chemin détaillé)
+		etapeHpa(partie, numero, aEtoile, &xCible, &yCible);
+		directionSerpent(partie, numero, xCible, yCible, aEtoile);
+	}
+	classerReplis(partie, numero);
+}
+
+void evaluerDirectionsChamp(tPartie *partie, int numero)
+{
+	// coût de chaque direction : distance à la pomme de sa case d'arrivée,
+	// 0 pour toutes quand aucune stratégie en jeu n'utilise le champ de distances
+	tSerpent *serpent = &partie->serpents[numero];
+	int xSuivant, ySuivant;
+	for (int a = 0 ; a < 4 ; a++)
+	{
+		serpent->couts[a] = 0;
+		if (partie->champAJour)
+		{
+			positionSuivante(serpent->lesX[serpent->tete], serpent->lesY[serpent->tete], HAUT + a, &xSuivant, &ySuivant);
+			serpent->couts[a] = partie->distancesPomme[CASE(xSuivant, ySuivant)];
+		}
+	}
+}
+
+void classerReplis(tPartie *partie, int numero)
+{
+	// la direction retenue en tête, puis les autres directions qui ne mènent ni sur
+	// une bordure, ni sur un pavé, ni sur un corps, par coût croissant
+	// (à coût égal, dans l'ordre HAUT, BAS, GAUCHE, DROITE)
+	tSerpent *serpent = &partie->serpents[numero];
+	int xSuivant, ySuivant;
+
+	serpent->replis[0] = serpent->direction;
+	serpent->nbReplis = 1;
+	for (char direction = HAUT ; direction <= DROITE ; direction++)
+	{
+		if (direction == serpent->direction)
+		{
+			continue;
+		}
+		positionSuivante(serpent->lesX[serpent->tete], serpent->lesY[serpent->tete], direction, &xSuivant, &ySuivant);
+		int c = CASE(xSuivant, ySuivant);
+		if (partie->plateau[c] == BORDURE || partie->occupation[c] > 0)
+		{
+			continue;
+		}
+		int place = serpent->nbReplis++;
+		while (place > 1 && serpent->couts[serpent->replis[place - 1] - HAUT] > serpent->couts[direction - HAUT])
+		{
+			serpent->replis[place] = serpent->replis[place - 1];
+			place--;
+		}
+		serpent->replis[place] = direction;
+	}
+}
+
+char directionRepli(tPartie *partie, int numero)
+{
+	// première direction de repli dont la case n'est ni retenue par un serpent déjà départagé,
+	// ni visée par un autre serpent ; à défaut, la première qui n'est pas retenue ;
+	// à défaut encore, le serpent garde sa direction
+	tSerpent *serpent = &partie->serpents[numero];
+	int xSuivant, ySuivant;
+
+	for (int passe = 0 ; passe < 2 ; passe++)
+	{
+		for (int r = 0 ; r < serpent->nbReplis ; r++)
+		{
+			positionSuivante(serpent->lesX[serpent->tete], serpent->lesY[serpent->tete], serpent->replis[r], &xSuivant, &ySuivant);
+			int c = CASE(xSuivant, ySuivant);
+			if (testerBit(&partie->reservees, xSuivant, ySuivant))
+			{
+				continue;
+			}
+			if (passe == 0 && partie->annonces[c] > ((c == serpent->annonce) ? 1 : 0))
+			{
+				continue;
+			}
+			return serpent->replis[r];
+		}
+	}
+	return serpent->direction;
+}
+
+void annoncerDeplacements(tPartie *partie)
+{
+	// chaque serpent en jeu annonce la case où arrivera sa tête dans sa direction
+	// courante : les autres serpents évitent ces cases (voir verifierCollisionProchainDeplacement)
+	for (int i = 0 ; i < partie->nbSerpents ; i++)
+	{
+		tSerpent *serpent = &partie->serpents[i];
+		int x, y;
+		if (serpent->collision)
+		{
+			continue;
+		}
+		positionSuivante(serpent->lesX[serpent->tete], serpent->lesY[serpent->tete], serpent->direction, &x, &y);
+		serpent->annonce = CASE(x, y);
+		partie->annonces[serpent->annonce]++;
+	}
+}
+
+void corrigerAnnonce(tPartie *partie, int numero)
+{
+	// remplace l'annonce du serpent par la case où le mène la direction qu'il vient de choisir
+	tSerpent *serpent = &partie->serpents[numero];
+	int x, y;
+	partie->annonces[serpent->annonce]--;
+	positionSuivante(serpent->lesX[serpent->tete], serpent->lesY[serpent->tete], serpent->direction, &x, &y);
+	serpent->annonce = CASE(x, y);
+	partie->annonces[serpent->annonce]++;
+}
+
+void retirerAnnonces(tPartie *partie)
+{
+	// remet à zéro les cases annoncées par annoncerDeplacements
+	for (int i = 0 ; i < partie->nbSerpents ; i++)
+	{
+		if (!partie->serpents[i].collision)
+		{
+			partie->annonces[partie->serpents[i].annonce] = 0;
+		}
+	}
+}
+
+void positionSuivante(int x, int y, char direction, int *xSuivant, int *ySuivant)
+{
+    // case atteinte en partant de (x, y) dans la direction donnée,
+    // en passant de l'autre côté du plateau par les issues comme dans progresser
+    switch (direction)
+    {
+        case HAUT:
+            y--;
+            break;
+        case BAS:
+            y++;
+            break;
+        case GAUCHE:
+            x--;
+            break;
+        case DROITE:
+            x++;
+            break;
+    }
+    if (x <= 0)
+    {
+        x = largeurPlateau;
+    }
+    else if (x > largeurPlateau)
+    {
+        x = 1;
+    }
+    else if (y <= 0)
+    {
+        y = hauteurPlateau;
+    }
+    else if (y > hauteurPlateau)
+    {
+        y = 1;
+    }
+    *xSuivant = x;
+    *ySuivant = y;
+}
+
+void calculerChampDistances(tPartie *partie, int xPomme, int yPomme)
+{
+    // parcours en largeur depuis la pomme : chaque case reçoit le nombre de déplacements
+    // nécessaires pour atteindre la pomme en contournant bordures et pavés,
+    // les issues étant des arêtes comme les autres
+    // (les déplacements sont réversibles, la distance de la pomme à une case est donc
+    // aussi celle de la case à la pomme)
+    // (la file contient les indices CASE(x, y) des cases atteintes)
+    int *file;
+    size_t debut = 0, fin = 0;
+    int x, y, xVoisin, yVoisin;
+
+    if (partie->distancesPomme == NULL)
+    {
+        partie->distancesPomme = allouerMemoire(NB_CASES * sizeof(int));
+        partie->fileChamp = allouerMemoire(NB_CASES * sizeof(int));
+    }
+    file = partie->fileChamp;
+    for (size_t c = 0; c < NB_CASES; c++)
+    {
+        partie->distancesPomme[c] = DISTANCE_INFINIE;
+    }
+    partie->distancesPomme[CASE(xPomme, yPomme)] = 0;
+    file[fin++] = CASE(xPomme, yPomme);
+
+    while (debut < fin)
+    {
+        x = CASE_X(file[debut]);
+        y = CASE_Y(file[debut]);
+        debut++;
+        for (char direction = HAUT; direction <= DROITE; direction++)
+        {
+            positionSuivante(x, y, direction, &xVoisin, &yVoisin);
+            if (partie->plateau[CASE(xVoisin, yVoisin)] != BORDURE &&
+                partie->distancesPomme[CASE(xVoisin, yVoisin)] == DISTANCE_INFINIE)
+            {
+                partie->distancesPomme[CASE(xVoisin, yVoisin)] = partie->distancesPomme[CASE(x, y)] + 1;
+                file[fin++] = CASE(xVoisin, yVoisin);
+            }
+        }
+    }
+}
+
+char directionChamp(tPartie *partie, int numero)
+{
+    // parmi les directions sans collision, prend celle dont la case d'arrivée
+    // est la plus proche de la pomme d'après le champ de distances,
+    // en gardant la direction courante en cas d'égalité
+    tSerpent *serpent = &partie->serpents[numero];
+    int xTete = serpent->lesX[serpent->tete];
+    int yTete = serpent->lesY[serpent->tete];
+    char directionCourante = serpent->direction;
+    char meilleureDirection = directionCourante;
+    int meilleureDistance = DISTANCE_INFINIE;
+    int xSuivant, ySuivant;
+
+    if (!partie->champAJour)
+    {
+        calculerChampDistances(partie, partie->xPomme, partie->yPomme);
+        partie->champAJour = true;
+    }
+
+    for (char direction = HAUT; direction <= DROITE; direction++)
+    {
+        if (!verifierCollisionProchainDeplacement(partie, numero, direction))
+        {
+            positionSuivante(xTete, yTete, direction, &xSuivant, &ySuivant);
+            int distance = partie->distancesPomme[CASE(xSuivant, ySuivant)];
+            if (distance < meilleureDistance ||
+                (distance == meilleureDistance && direction == directionCourante))
+            {
+                meilleureDistance = distance;
+                meilleureDirection = direction;
+            }
+        }
+    }
+    return meilleureDirection;
+}
+
+char directionAEtoile(tPartie *partie, int numero, tAEtoile *aEtoile)
+{
+    // recherche A* du plus court chemin de la tête à la pomme, qui contourne
+    // bordures, pavés et corps des serpents et emprunte les issues,
+    // puis retourne la première direction de ce chemin
+    // (aEtoile est la mémoire de recherche du thread appelant)
+    tSerpent *serpent = &partie->serpents[numero];
+    int xTete = serpent->lesX[serpent->tete];
+    int yTete = serpent->lesY[serpent->tete];
+    int xBut = partie->xPomme;
+    int yBut = partie->yPomme;
+    int distancePortailBut = distanceIssuLaPlusProche(xBut, yBut);
+    bool trouve = false;
+    int xVoisin, yVoisin;
+    char premiereDirection;
+    tNoeud noeud;
+
+    // si même plateau vide la pomme est hors d'atteinte (enclavée par les pavés),
+    // inutile d'explorer tout le plateau
+    if (!partie->champAJour)
+    {
+        calculerChampDistances(partie, partie->xPomme, partie->yPomme);
+        partie->champAJour = true;
+    }
+    if (partie->distancesPomme[CASE(xTete, yTete)] == DISTANCE_INFINIE)
+    {
+        return directionChamp(partie, numero);
+    }
+
+    nouvelleRechercheAEtoile(aEtoile);
+
+    aEtoile->marque[CASE(xTete, yTete)] = aEtoile->numeroRecherche;
+    aEtoile->fermee[CASE(xTete, yTete)] = false;
+    aEtoile->g[CASE(xTete, yTete)] = 0;
+    insererTas(aEtoile, heuristiqueAEtoile(xTete, yTete, xBut, yBut, distancePortailBut), 0, xTete, yTete);
+
+    while (aEtoile->tailleTas > 0 && !trouve)
+    {
+        noeud = extraireTas(aEtoile);
+        if (aEtoile->fermee[CASE(noeud.x, noeud.y)] || noeud.g > aEtoile->g[CASE(noeud.x, noeud.y)])
+        {
+            continue; // entrée périmée du tas
+        }
+        aEtoile->fermee[CASE(noeud.x, noeud.y)] = true;
+        if (noeud.x == xBut && noeud.y == yBut)
+        {
+            trouve = true;
+            continue;
+        }
+
+        for (char direction = HAUT; direction <= DROITE; direction++)
+        {
+            positionSuivante(noeud.x, noeud.y, direction, &xVoisin, &yVoisin);
+            // les queues des serpents libèrent leur case au prochain déplacement
+            if (partie->plateau[CASE(xVoisin, yVoisin)] == BORDURE ||
+                (partie->occupation[CASE(xVoisin, yVoisin)] > 0 && !testerBit(&partie->queues, xVoisin, yVoisin)))
+            {
+                continue;
+            }
+            int g = noeud.g + 1;
+            if (aEtoile->marque[CASE(xVoisin, yVoisin)] != aEtoile->numeroRecherche)
+            {
+                aEtoile->marque[CASE(xVoisin, yVoisin)] = aEtoile->numeroRecherche;
+                aEtoile->fermee[CASE(xVoisin, yVoisin)] = false;
+            }
+            else if (aEtoile->fermee[CASE(xVoisin, yVoisin)] || g >= aEtoile->g[CASE(xVoisin, yVoisin)])
+            {
+                continue;
+            }
+            aEtoile->g[CASE(xVoisin, yVoisin)] = g;
+            aEtoile->arrivee[CASE(xVoisin, yVoisin)] = direction;
+            insererTas(aEtoile, g + heuristiqueAEtoile(xVoisin, yVoisin, xBut, yBut, distancePortailBut), g, xVoisin, yVoisin);
+        }
+    }
+
+    // sans chemin libre jusqu'à la pomme, le serpent se met à l'abri dans le plus grand espace
+    if (!trouve)
+    {
+        return directionPlusGrandEspace(partie, numero, aEtoile);
+    }
+    if (xTete == xBut && yTete == yBut)
+    {
+        return directionChamp(partie, numero);
+    }
+
+    // remonte le chemin depuis la pomme jusqu'à la case voisine de la tête
+    // (reculer dans la direction opposée ramène sur la case précédente, issues comprises)
+    int x = xBut, y = yBut;
+    const char OPPOSEE[] = {0, BAS, HAUT, DROITE, GAUCHE};
+    do
+    {
+        premiereDirection = aEtoile->arrivee[CASE(x, y)];
+        positionSuivante(x, y, OPPOSEE[(int)premiereDirection], &x, &y);
+    } while (x != xTete || y != yTete);
+
+    // le chemin ne tient pas compte du prochain déplacement des adversaires
+    if (verifierCollisionProchainDeplacement(partie, numero, premiereDirection))
+    {
+        return directionChamp(partie, numero);
+    }
+    return premiereDirection;
+}
+
+void nouvelleRechercheAEtoile(tAEtoile *aEtoile)
+{
+    // prépare la mémoire pour une nouvelle recherche (allouée à la première) :
+    // toutes les marques précédentes deviennent obsolètes
+    if (aEtoile->marque == NULL)
+    {
+        aEtoile->marque = allouerMemoire(NB_CASES * sizeof(unsigned int));
+        aEtoile->fermee = allouerMemoire(NB_CASES * sizeof(bool));
+        aEtoile->g = allouerMemoire(NB_CASES * sizeof(int));
+        aEtoile->arrivee = allouerMemoire(NB_CASES);
+        aEtoile->numeroRecherche = 0;
+    }
+    aEtoile->numeroRecherche++;
+    if (aEtoile->numeroRecherche == 0)
+    {
+        memset(aEtoile->marque, 0, NB_CASES * sizeof(unsigned int));
+        aEtoile->numeroRecherche = 1;
+    }
+    aEtoile->tailleTas = 0;
+}
+
+void libererAEtoile(tAEtoile *aEtoile)
+{
+    free(aEtoile->marque);
+    free(aEtoile->fermee);
+    free(aEtoile->g);
+    free(aEtoile->arrivee);
+    free(aEtoile->tas);
+    libererBitboard(&aEtoile->atteintes);
+    libererBitboard(&aEtoile->nouvelles);
+}
+
+int distanceIssuLaPlusProche(int x, int y)
+{
+    // distance de Manhattan de la case à l'issue la plus proche
+    int issuesX[4] = {xIssues, xIssues, 1, largeurPlateau};
+    int issuesY[4] = {1, hauteurPlateau, yIssues, yIssues};
+    int minimum = DISTANCE_INFINIE;
+    for (int i = 0; i < 4; i++)
+    {
+        int distance = abs(x - issuesX[i]) + abs(y - issuesY[i]);
+        if (distance < minimum)
+        {
+            minimum = distance;
+        }
+    }
+    return minimum;
+}
+
+int heuristiqueAEtoile(int x, int y, int xBut, int yBut, int distancePortailBut)
+{
+    // minorant du nombre de déplacements jusqu'au but : soit le chemin direct,
+    // soit une issue atteinte, franchie en un déplacement, puis une issue jusqu'au but
+    // (distancePortailBut est la distance du but à l'issue la plus proche)
+    int direct = abs(x - xBut) + abs(y - yBut);
+    int parIssue = distanceIssuLaPlusProche(x, y) + 1 + distancePortailBut;
+    return (direct < parIssue) ? direct : parIssue;
+}
+
+void insererTas(tAEtoile *aEtoile, int f, int g, int x, int y)
+{
+    // tas binaire minimum sur f, à f égal le noeud le plus avancé (g le plus grand) d'abord
+    if (aEtoile->tailleTas == aEtoile->capaciteTas)
+    {
+        aEtoile->capaciteTas = (aEtoile->capaciteTas == 0) ? 1024 : 2 * aEtoile->capaciteTas;
+        aEtoile->tas = realloc(aEtoile->tas, aEtoile->capaciteTas * sizeof(tNoeud));
+        if (aEtoile->tas == NULL)
+        {
+            perror("realloc");
+            exit(EXIT_FAILURE);
+        }
+    }
+    int i = aEtoile->tailleTas++;
+    tNoeud noeud = {f, g, x, y};
+    while (i > 0)
+    {
+        int parent = (i - 1) / 2;
+        tNoeud *p = &aEtoile->tas[parent];
+        if (p->f < f || (p->f == f && p->g >= g))
+        {
+            break;
+        }
+        aEtoile->tas[i] = *p;
+        i = parent;
+    }
+    aEtoile->tas[i] = noeud;
+}
+
+tNoeud extraireTas(tAEtoile *aEtoile)
+{
+    tNoeud racine = aEtoile->tas[0];
+    tNoeud dernier = aEtoile->tas[--aEtoile->tailleTas];
+    int i = 0;
+    int n = aEtoile->tailleTas;
+    while (2 * i + 1 < n)
+    {
+        int fils = 2 * i + 1;
+        tNoeud *a = &aEtoile->tas[fils];
+        if (fils + 1 < n)
+        {
+            tNoeud *b = &aEtoile->tas[fils + 1];
+            if (b->f < a->f || (b->f == a->f && b->g > a->g))
+            {
+                fils++;
+                a = b;
+            }
+        }
+        if (dernier.f < a->f || (dernier.f == a->f && dernier.g >= a->g))
+        {
+            break;
+        }
+        aEtoile->tas[i] = *a;
+        i = fils;
+    }
+    aEtoile->tas[i] = dernier;
+    return racine;
+}
+
+char directionDStar(tPartie *partie, int numero, tAEtoile *aEtoile)
+{
+    // D* Lite : la recherche du tour précédent est conservée, on ne reprend que
+    // les cases dont l'état a changé (celles où des serpents sont arrivés ou d'où ils sont
+    // partis), puis on suit la case voisine la plus proche de la pomme
+    tSerpent *serpent = &partie->serpents[numero];
+    tDStar *dStar = &serpent->dStar;
+    int xTete = serpent->lesX[serpent->tete];
+    int yTete = serpent->lesY[serpent->tete];
+    char directionCourante = serpent->direction;
+    char meilleureDirection = directionCourante;
+    int meilleureDistance = DISTANCE_INFINIE;
+    int xVoisin, yVoisin;
+
+    if (!dStar->initialise || dStar->xBut != partie->xPomme || dStar->yBut != partie->yPomme)
+    {
+        // nouvelle pomme : nouvelle recherche complète
+        initialiserDStar(partie, dStar, xTete, yTete);
+    }
+    else
+    {
+        int xAncienDepart = dStar->xDepart, yAncienDepart = dStar->yDepart;
+
+        // la tête a avancé : les clés déjà calculées sont corrigées globalement par km
+        if (xTete != dStar->xDepart || yTete != dStar->yDepart)
+        {
+            dStar->km += heuristiqueAEtoile(dStar->xDepart, dStar->yDepart, xTete, yTete,
+                                            distanceIssuLaPlusProche(xTete, yTete));
+            dStar->xDepart = xTete;
+            dStar->yDepart = yTete;
+            dStar->distancePortailDepart = distanceIssuLaPlusProche(xTete, yTete);
+        }
+
+        // cases qui ont pu changer depuis le dernier calcul : celles dont l'occupation
+        // a changé aux derniers déplacements, plus l'ancienne et la nouvelle tête
+        // (seule case occupée que la recherche considère comme libre)
+        for (int i = 0; i < partie->nbCasesModifiees; i++)
+        {
+            reprendreCaseDStar(partie, dStar, CASE_X(partie->casesModifiees[i]), CASE_Y(partie->casesModifiees[i]));
+        }
+        reprendreCaseDStar(partie, dStar, xAncienDepart, yAncienDepart);
+        reprendreCaseDStar(partie, dStar, xTete, yTete);
+    }
+
+    calculerCheminDStar(dStar);
+
+    // case voisine libre la plus proche de la pomme, sans collision au prochain déplacement
+    for (char direction = HAUT; direction <= DROITE; direction++)
+    {
+        positionSuivante(xTete, yTete, direction, &xVoisin, &yVoisin);
+        int distance = dStar->g[CASE(xVoisin, yVoisin)];
+        if (dStar->bloquee[CASE(xVoisin, yVoisin)] || distance == DISTANCE_INFINIE)
+        {
+            continue;
+        }
+        bool collision = verifierCollisionProchainDeplacement(partie, numero, direction);
+        if (!collision && (distance < meilleureDistance ||
+                           (distance == meilleureDistance && direction == directionCourante)))
+        {
+            meilleureDistance = distance;
+            meilleureDirection = direction;
+        }
+    }
+    if (meilleureDistance == DISTANCE_INFINIE)
+    {
+        return directionPlusGrandEspace(partie, numero, aEtoile);
+    }
+    return meilleureDirection;
+}
+
+void initialiserDStar(tPartie *partie, tDStar *dStar, int xDepart, int yDepart)
+{
+    dStar->initialise = true;
+    dStar->xBut = partie->xPomme;
+    dStar->yBut = partie->yPomme;
+    dStar->xDepart = xDepart;
+    dStar->yDepart = yDepart;
+    dStar->distancePortailDepart = distanceIssuLaPlusProche(xDepart, yDepart);
+    dStar->km = 0;
+    dStar->tailleTas = 0;
+    if (dStar->g == NULL)
+    {
+        dStar->g = allouerMemoire(NB_CASES * sizeof(int));
+        dStar->rhs = allouerMemoire(NB_CASES * sizeof(int));
+        dStar->bloquee = allouerMemoire(NB_CASES * sizeof(bool));
+        dStar->cle1 = allouerMemoire(NB_CASES * sizeof(int));
+        dStar->cle2 = allouerMemoire(NB_CASES * sizeof(int));
+        dStar->place = allouerMemoire(NB_CASES * sizeof(int));
+        dStar->tas = allouerMemoire(NB_CASES * sizeof(int));
+    }
+    for (int y = 1; y <= hauteurPlateau; y++)
+    {
+        for (int x = 1; x <= largeurPlateau; x++)
+        {
+            dStar->g[CASE(x, y)] = DISTANCE_INFINIE;
+            dStar->rhs[CASE(x, y)] = DISTANCE_INFINIE;
+            dStar->place[CASE(x, y)] = -1;
+            dStar->bloquee[CASE(x, y)] = caseBloqueeDStar(partie, dStar, x, y);
+        }
+    }
+    dStar->rhs[CASE(dStar->xBut, dStar->yBut)] = 0;
+    placerTasDStar(dStar, dStar->xBut, dStar->yBut,
+                   heuristiqueAEtoile(dStar->xBut, dStar->yBut, xDepart, yDepart, dStar->distancePortailDepart), 0);
+}
+
+bool caseBloqueeDStar(tPartie *partie, tDStar *dStar, int x, int y)
+{
+    // bordures, pavés et corps des serpents, sauf la tête du serpent qui cherche son chemin
+    if (x == dStar->xDepart && y == dStar->yDepart)
+    {
+        return false;
+    }
+    return partie->plateau[CASE(x, y)] == BORDURE || partie->occupation[CASE(x, y)] > 0;
+}
+
+void reprendreCaseDStar(tPartie *partie, tDStar *dStar, int x, int y)
+{
+    // si la case est devenue libre ou bloquée depuis le dernier calcul,
+    // elle et ses voisines sont réévaluées
+    bool bloquee = caseBloqueeDStar(partie, dStar, x, y);
+    int xVoisin, yVoisin;
+    if (bloquee != dStar->bloquee[CASE(x, y)])
+    {
+        dStar->bloquee[CASE(x, y)] = bloquee;
+        mettreAJourCaseDStar(dStar, x, y);
+        for (char direction = HAUT; direction <= DROITE; direction++)
+        {
+            positionSuivante(x, y, direction, &xVoisin, &yVoisin);
+            mettreAJourCaseDStar(dStar, xVoisin, yVoisin);
+        }
+    }
+}
+
+void mettreAJourCaseDStar(tDStar *dStar, int x, int y)
+{
+    // recalcule rhs (meilleure distance en passant par un voisin) puis remet la case
+    // dans la file si elle est incohérente (g != rhs), l'en retire sinon
+    int xVoisin, yVoisin;
+    if (x != dStar->xBut || y != dStar->yBut)
+    {
+        int minimum = DISTANCE_INFINIE;
+        if (!dStar->bloquee[CASE(x, y)])
+        {
+            for (char direction = HAUT; direction <= DROITE; direction++)
+            {
+                positionSuivante(x, y, direction, &xVoisin, &yVoisin);
+                int g = dStar->g[CASE(xVoisin, yVoisin)];
+                if (!dStar->bloquee[CASE(xVoisin, yVoisin)] && g != DISTANCE_INFINIE && g + 1 < minimum)
+                {
+                    minimum = g + 1;
+                }
+            }
+        }
+        dStar->rhs[CASE(x, y)] = minimum;
+    }
+    if (dStar->g[CASE(x, y)] != dStar->rhs[CASE(x, y)])
+    {
+        int cle1, cle2;
+        calculerCleDStar(dStar, x, y, &cle1, &cle2);
+        placerTasDStar(dStar, x, y, cle1, cle2);
+    }
+    else if (dStar->place[CASE(x, y)] != -1)
+    {
+        retirerTasDStar(dStar, x, y);
+    }
+}
+
+void calculerCheminDStar(tDStar *dStar)
+{
+    int xDepart = dStar->xDepart, yDepart = dStar->yDepart;
+    int cleDepart1, cleDepart2, cle1, cle2;
+    int xVoisin, yVoisin;
+
+    calculerCleDStar(dStar, xDepart, yDepart, &cleDepart1, &cleDepart2);
+    while (dStar->tailleTas > 0)
+    {
+        int u = dStar->tas[0];
+        int x = CASE_X(u), y = CASE_Y(u);
+        int ancienneCle1 = dStar->cle1[CASE(x, y)], ancienneCle2 = dStar->cle2[CASE(x, y)];
+
+        // arrêt dès que la tête est cohérente et qu'aucune case en attente ne peut l'améliorer
+        if ((ancienneCle1 > cleDepart1 || (ancienneCle1 == cleDepart1 && ancienneCle2 >= cleDepart2)) &&
+            dStar->rhs[CASE(xDepart, yDepart)] == dStar->g[CASE(xDepart, yDepart)])
+        {
+            break;
+        }
+
+        calculerCleDStar(dStar, x, y, &cle1, &cle2);
+        if (ancienneCle1 < cle1 || (ancienneCle1 == cle1 && ancienneCle2 < cle2))
+        {
+            // clé périmée par les déplacements de la tête
+            placerTasDStar(dStar, x, y, cle1, cle2);
+        }
+        else if (dStar->g[CASE(x, y)] > dStar->rhs[CASE(x, y)])
+        {
+            // la case se rapproche de la pomme : ses voisins en profitent
+            dStar->g[CASE(x, y)] = dStar->rhs[CASE(x, y)];
+            retirerTasDStar(dStar, x, y);
+            for (char direction = HAUT; direction <= DROITE; direction++)
+            {
+                positionSuivante(x, y, direction, &xVoisin, &yVoisin);
+                mettreAJourCaseDStar(dStar, xVoisin, yVoisin);
+            }
+        }
+        else
+        {
+            // la case s'éloigne de la pomme : elle et ses voisins sont réévalués
+            dStar->g[CASE(x, y)] = DISTANCE_INFINIE;
+            mettreAJourCaseDStar(dStar, x, y);
+            for (char direction = HAUT; direction <= DROITE; direction++)
+            {
+                positionSuivante(x, y, direction, &xVoisin, &yVoisin);
+                mettreAJourCaseDStar(dStar, xVoisin, yVoisin);
+            }
+        }
+        calculerCleDStar(dStar, xDepart, yDepart, &cleDepart1, &cleDepart2);
+    }
+}
+
+void calculerCleDStar(tDStar *dStar, int x, int y, int *cle1, int *cle2)
+{
+    int minimum = (dStar->g[CASE(x, y)] < dStar->rhs[CASE(x, y)]) ? dStar->g[CASE(x, y)] : dStar->rhs[CASE(x, y)];
+    if (minimum == DISTANCE_INFINIE)
+    {
+        *cle1 = DISTANCE_INFINIE;
+    }
+    else
+    {
+        *cle1 = minimum + dStar->km +
+            heuristiqueAEtoile(x, y, dStar->xDepart, dStar->yDepart, dStar->distancePortailDepart);
+    }
+    *cle2 = minimum;
+}
+
+void placerTasDStar(tDStar *dStar, int x, int y, int cle1, int cle2)
+{
+    // insère la case dans le tas ou met à jour sa clé si elle y est déjà
+    int c = CASE(x, y);
+    int i = dStar->place[c];
+    dStar->cle1[c] = cle1;
+    dStar->cle2[c] = cle2;
+    if (i == -1)
+    {
+        i = dStar->tailleTas++;
+        dStar->tas[i] = c;
+        dStar->place[c] = i;
+    }
+    remonterTasDStar(dStar, i);
+    descendreTasDStar(dStar, dStar->place[c]);
+}
+
+void retirerTasDStar(tDStar *dStar, int x, int y)
+{
+    int i = dStar->place[CASE(x, y)];
+    int dernier = dStar->tas[--dStar->tailleTas];
+    dStar->place[CASE(x, y)] = -1;
+    if (i < dStar->tailleTas)
+    {
+        dStar->tas[i] = dernier;
+        dStar->place[dernier] = i;
+        remonterTasDStar(dStar, i);
+        descendreTasDStar(dStar, dStar->place[dernier]);
+    }
+}
+
+void remonterTasDStar(tDStar *dStar, int i)
+{
+    int c = dStar->tas[i];
+    while (i > 0)
+    {
+        int parent = (i - 1) / 2;
+        int p = dStar->tas[parent];
+        if (dStar->cle1[p] < dStar->cle1[c] ||
+            (dStar->cle1[p] == dStar->cle1[c] && dStar->cle2[p] <= dStar->cle2[c]))
+        {
+            break;
+        }
+        dStar->tas[i] = p;
+        dStar->place[p] = i;
+        i = parent;
+    }
+    dStar->tas[i] = c;
+    dStar->place[c] = i;
+}
+
+void descendreTasDStar(tDStar *dStar, int i)
+{
+    int c = dStar->tas[i];
+    int n = dStar->tailleTas;
+    while (2 * i + 1 < n)
+    {
+        int fils = 2 * i + 1;
+        int f = dStar->tas[fils];
+        if (fils + 1 < n)
+        {
+            int b = dStar->tas[fils + 1];
+            if (dStar->cle1[b] < dStar->cle1[f] ||
+                (dStar->cle1[b] == dStar->cle1[f] && dStar->cle2[b] < dStar->cle2[f]))
+            {
+                fils++;
+                f = b;
+            }
+        }
+        if (dStar->cle1[c] < dStar->cle1[f] ||
+            (dStar->cle1[c] == dStar->cle1[f] && dStar->cle2[c] <= dStar->cle2[f]))
+        {
+            break;
+        }
+        dStar->tas[i] = f;
+        dStar->place[f] = i;
+        i = fils;
+    }
+    dStar->tas[i] = c;
+    dStar->place[c] = i;
+}
+
+char directionPlusGrandEspace(tPartie *partie, int numero, tAEtoile *aEtoile)
+{
+    // quand la pomme est hors d'atteinte : direction sans collision depuis laquelle
+    // le plus grand nombre de cases libres reste accessible ; au-delà de deux fois la longueur
+    // à venir du serpent, toutes les zones se valent et le remplissage s'arrête
+    // (aEtoile fournit les plateaux bit à bit du thread appelant)
+    tSerpent *serpent = &partie->serpents[numero];
+    int xTete = serpent->lesX[serpent->tete];
+    int yTete = serpent->lesY[serpent->tete];
+    int borne = 2 * (serpent->longueur + serpent->aGrandir);
+    char meilleureDirection = serpent->direction;
+    int meilleurEspace = -1;
+    int xSuivant, ySuivant;
+
+    preparerRemplissage(aEtoile);
+    for (char direction = HAUT; direction <= DROITE; direction++)
+    {
+        if (!verifierCollisionProchainDeplacement(partie, numero, direction))
+        {
+            positionSuivante(xTete, yTete, direction, &xSuivant, &ySuivant);
+            int espace = remplirDepuis(partie, xSuivant, ySuivant, borne, aEtoile);
+            if (espace > meilleurEspace)
+            {
+                meilleurEspace = espace;
+                meilleureDirection = direction;
+            }
+        }
+    }
+    return meilleureDirection;
+}
+
+void preparerCycle(tPartie *partie)
+{
+    // calcule le cycle hamiltonien de la carte courante si un serpent joue la stratégie
+    // hamilton et que le cycle en mémoire a été fait pour une autre disposition des pavés
+    // (dimensions, issues et taille des pavés sont les mêmes pour toutes les parties)
+    bool utilise = false;
+    for (int i = 0; i < partie->nbSerpents; i++)
+    {
+        utilise = utilise || partie->serpents[i].strategie == STRATEGIE_HAMILTON;
+    }
+    if (!utilise)
+    {
+        return;
+    }
+    if (partie->cycleCalcule &&
+        memcmp(partie->cyclePavesX, partie->lesPavesX, sizeof(partie->cyclePavesX)) == 0 &&
+        memcmp(partie->cyclePavesY, partie->lesPavesY, sizeof(partie->cyclePavesY)) == 0)
+    {
+        return;
+    }
+    // repris du cache s'il y est, sinon calculé puis ajouté au cache
+    libererCycle(partie);
+    if (!chargerCycle(partie))
+    {
+        calculerCycleHamiltonien(partie);
+        ecrireCache(partie, CACHE_CYCLE, partie->longueurCycle, partie->rangCycle, NB_CASES * sizeof(int),
+                    partie->casesCycle, partie->longueurCycle * sizeof(int));
+    }
+    memcpy(partie->cyclePavesX, partie->lesPavesX, sizeof(partie->cyclePavesX));
+    memcpy(partie->cyclePavesY, partie->lesPavesY, sizeof(partie->cyclePavesY));
+    partie->cycleCalcule = true;
+}
+
+void calculerCycleHamiltonien(tPartie *partie)
+{
+    // l'intérieur du plateau est découpé en blocs de 2 x 2 cases ; un arbre couvrant
+    // (parcours en largeur) relie les blocs sans bordure ni pavé de la plus grande zone d'un
+    // seul tenant, et le tour de cet arbre passe une fois par chacune de leurs cases.
+    // Dans un bloc de coin supérieur gauche (x, y), chaque case a pour suivante :
+    //   (x, y)         : à gauche si le bloc est relié à son voisin de gauche, sinon en dessous
+    //   (x, y + 1)     : en dessous si relié au voisin du dessous, sinon à droite
+    //   (x + 1, y + 1) : à droite si relié au voisin de droite, sinon au-dessus
+    //   (x + 1, y)     : au-dessus si relié au voisin du dessus, sinon à gauche
+    // Le cycle est ensuite allongé par des détours : une arête a -> b qui longe deux cases
+    // libres voisines c et d encore hors du cycle (c voisine de a, d voisine de b) devient
+    // a -> c -> d -> b, ce qui reprend la plupart des cases le long des pavés et la dernière
+    // ligne ou colonne d'un plateau de taille impaire.
+    // Le cycle ne passe donc pas par toutes les cases libres : les issues en restent toujours
+    // hors (une issue n'a pour voisines que la case intérieure devant elle et l'issue opposée,
+    // le cycle devrait traverser le plateau par elle et revenir par un autre chemin), comme
+    // les cases qu'aucun détour n'a pu prendre ; directionHamilton les traverse sans le cycle.
+    size_t nbBlocsX = (size_t)(largeurPlateau - 2) / 2;
+    size_t nbBlocsY = (size_t)(hauteurPlateau - 2) / 2;
+    size_t nbBlocs = nbBlocsX * nbBlocsY;
+    int *parent = allouerMemoire(nbBlocs * sizeof(int));
+    int *zone = allouerMemoire(nbBlocs * sizeof(int));
+    int *file = allouerMemoire(nbBlocs * sizeof(int));
+    unsigned char *liens = allouerMemoire(nbBlocs * sizeof(*liens));
+    int *suivante = allouerMemoire(NB_CASES * sizeof(int));
+    int meilleureZone = -1, racine = -1;
+    size_t tailleMeilleureZone = 0;
+
+    if (partie->rangCycle == NULL)
+    {
+        partie->rangCycle = allouerMemoire(NB_CASES * sizeof(int));
+        partie->casesCycle = allouerMemoire(NB_CASES * sizeof(int));
+    }
+    for (size_t c = 0; c < NB_CASES; c++)
+    {
+        partie->rangCycle[c] = -1;
+    }
+
+    // blocs libres, puis zones d'un seul tenant avec leur arbre couvrant
+    for (size_t b = 0; b < nbBlocs; b++)
+    {
+        int x = 2 + 2 * (int)(b % nbBlocsX), y = 2 + 2 * (int)(b / nbBlocsX);
+        bool libre = partie->plateau[CASE(x, y)] != BORDURE && partie->plateau[CASE(x + 1, y)] != BORDURE &&
+                     partie->plateau[CASE(x, y + 1)] != BORDURE && partie->plateau[CASE(x + 1, y + 1)] != BORDURE;
+        zone[b] = libre ? -1 : -2;
+        parent[b] = -1;
+    }
+    for (size_t depart = 0; depart < nbBlocs; depart++)
+    {
+        if (zone[depart] != -1)
+        {
+            continue;
+        }
+        size_t debut = 0, fin = 0;
+        zone[depart] = (int)depart;
+        file[fin++] = (int)depart;
+        while (debut < fin)
+        {
+            size_t b = (size_t)file[debut++];
+            size_t bx = b % nbBlocsX, by = b / nbBlocsX;
+            // blocs voisins (nbBlocs quand il n'y en a pas de ce côté)
+            size_t voisins[4] = {(by > 0) ? b - nbBlocsX : nbBlocs, (by + 1 < nbBlocsY) ? b + nbBlocsX : nbBlocs,
+                                 (bx > 0) ? b - 1 : nbBlocs, (bx + 1 < nbBlocsX) ? b + 1 : nbBlocs};
+            for (int v = 0; v < 4; v++)
+            {
+                if (voisins[v] < nbBlocs && zone[voisins[v]] == -1)
+                {
+                    zone[voisins[v]] = (int)depart;
+                    parent[voisins[v]] = (int)b;
+                    file[fin++] = (int)voisins[v];
+                }
+            }
+        }
+        if (fin > tailleMeilleureZone)
+        {
+            tailleMeilleureZone = fin;
+            meilleureZone = (int)depart;
+        }
+    }
+
+    // liens de l'arbre de la plus grande zone, dans les deux sens
+    for (size_t b = 0; b < nbBlocs; b++)
+    {
+        if (zone[b] != meilleureZone || meilleureZone < 0)
+        {
+            continue;
+        }
+        racine = (parent[b] < 0) ? (int)b : racine;
+        if (parent[b] >= 0)
+        {
+            size_t p = (size_t)parent[b];
+            int versParent = (p + nbBlocsX == b) ? LIEN_HAUT : (p == b + nbBlocsX) ? LIEN_BAS :
+                             (p + 1 == b) ? LIEN_GAUCHE : LIEN_DROITE;
+            int versEnfant = (versParent == LIEN_HAUT) ? LIEN_BAS : (versParent == LIEN_BAS) ? LIEN_HAUT :
+                             (versParent == LIEN_GAUCHE) ? LIEN_DROITE : LIEN_GAUCHE;
+            liens[b] |= versParent;
+            liens[p] |= versEnfant;
+        }
+    }
+
+    // case suivante de chaque case des blocs retenus (marquées d'un rang 0 jusqu'au calcul des rangs)
+    partie->longueurCycle = 4 * (int)tailleMeilleureZone;
+    for (size_t b = 0; b < nbBlocs && racine >= 0; b++)
+    {
+        if (zone[b] != meilleureZone)
+        {
+            continue;
+        }
+        int x = 2 + 2 * (int)(b % nbBlocsX), y = 2 + 2 * (int)(b / nbBlocsX);
+        suivante[CASE(x, y)] = (liens[b] & LIEN_GAUCHE) ? CASE(x - 1, y) : CASE(x, y + 1);
+        suivante[CASE(x, y + 1)] = (liens[b] & LIEN_BAS) ? CASE(x, y + 2) : CASE(x + 1, y + 1);
+        suivante[CASE(x + 1, y + 1)] = (liens[b] & LIEN_DROITE) ? CASE(x + 2, y + 1) : CASE(x + 1, y);
+        suivante[CASE(x + 1, y)] = (liens[b] & LIEN_HAUT) ? CASE(x + 1, y - 1) : CASE(x, y);
+        partie->rangCycle[CASE(x, y)] = 0;
+        partie->rangCycle[CASE(x, y + 1)] = 0;
+        partie->rangCycle[CASE(x + 1, y + 1)] = 0;
+        partie->rangCycle[CASE(x + 1, y)] = 0;
+    }
+
+    // détours, repris tant qu'ils en permettent de nouveaux
+    bool allonge = (racine >= 0);
+    while (allonge)
+    {
+        allonge = false;
+        for (int y = 2; y < hauteurPlateau; y++)
+        {
+            for (int x = 2; x < largeurPlateau; x++)
+            {
+                int a = CASE(x, y);
+                if (partie->rangCycle[a] < 0)
+                {
+                    continue;
+                }
+                int b = suivante[a];
+                int dx = CASE_X(b) - x, dy = CASE_Y(b) - y;
+                // c et d de l'un ou l'autre côté de l'arête
+                for (int cote = -1; cote <= 1; cote += 2)
+                {
+                    int xc = x + cote * dy, yc = y + cote * dx;
+                    if (caseDetourCycle(partie, xc, yc) && caseDetourCycle(partie, xc + dx, yc + dy))
+                    {
+                        int c = CASE(xc, yc), d = CASE(xc + dx, yc + dy);
+                        suivante[a] = c;
+                        suivante[c] = d;
+                        suivante[d] = b;
+                        partie->rangCycle[c] = 0;
+                        partie->rangCycle[d] = 0;
+                        partie->longueurCycle += 2;
+                        allonge = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    // rangs le long du cycle
+    if (racine >= 0)
+    {
+        int c = CASE(2 + 2 * (racine % (int)nbBlocsX), 2 + 2 * (racine / (int)nbBlocsX));
+        for (int rang = 0; rang < partie->longueurCycle; rang++)
+        {
+            partie->casesCycle[rang] = c;
+            partie->rangCycle[c] = rang;
+            c = suivante[c];
+        }
+    }
+
+    free(parent);
+    free(zone);
+    free(file);
+    free(liens);
+    free(suivante);
+}
+
+bool caseDetourCycle(tPartie *partie, int x, int y)
+{
+    // case de l'intérieur du plateau, ni bordure ni pavé, que le cycle ne prend pas encore
+    return x >= 2 && x < largeurPlateau && y >= 2 && y < hauteurPlateau &&
+           partie->plateau[CASE(x, y)] != BORDURE && partie->rangCycle[CASE(x, y)] < 0;
+}
+
+char directionHamilton(tPartie *partie, int numero, tAEtoile *aEtoile)
+{
+    // tant que son corps (anneaux à venir compris) tient dans moins d'un PART_CYCLE-ième du
+    // cycle, le serpent joue la stratégie champ en évitant les poches trop petites pour lui
+    // (directionChampSure) : le plateau est presque vide et ce chemin est le plus court.
+    // Plus long, il suit le cycle hamiltonien : tant que son corps est rangé le long du cycle
+    // derrière sa tête, les cases entre sa tête et sa queue sont libres et il ne peut pas
+    // s'enfermer. Il prend le plus court chemin jusqu'à la pomme s'il avance le long du cycle
+    // sans dépasser sa queue (voir raccourciPomme), sinon un raccourci vers une case voisine
+    // plus loin sur le cycle qui ne la dépasse pas (moins les anneaux qui vont lui pousser et
+    // une marge). Parmi ces cases, il préfère celles qui ne dépassent pas la pomme sur le cycle
+    // (il s'en rapproche alors à chaque tour), puis, les corps des autres serpents pouvant
+    // se trouver devant lui sur le cycle, celles au-delà du dernier corps rencontré avant
+    // sa queue, puis la plus proche de la pomme d'après le champ de distances, puis la plus avancée.
+    // Hors du cycle, ou sans case sûre sur le cycle, il reprend directionChampSure.
+    tSerpent *serpent = &partie->serpents[numero];
+    int xTete = serpent->lesX[serpent->tete];
+    int yTete = serpent->lesY[serpent->tete];
+    int longueurCycle = partie->longueurCycle;
+    int rangTete = (longueurCycle > 0) ? partie->rangCycle[CASE(xTete, yTete)] : -1;
+    char meilleureDirection = 0;
+    int meilleurePriorite = 0, meilleureDistance = 0, meilleureAvance = 0;
+    int xSuivant, ySuivant;
+
+    if (rangTete < 0 || (serpent->longueur + serpent->aGrandir) * PART_CYCLE < longueurCycle)
+    {
+        return directionChampSure(partie, numero, aEtoile);
+    }
+    if (!partie->champAJour)
+    {
+        calculerChampDistances(partie, partie->xPomme, partie->yPomme);
+        partie->champAJour = true;
+    }
+
+    // avance maximale sur le cycle : jusqu'à la queue si elle est sur le cycle,
+    // jamais plus que les cases que le corps n'occupe pas
+    int queue = indiceQueue(serpent);
+    int rangQueue = partie->rangCycle[CASE(serpent->lesX[queue], serpent->lesY[queue])];
+    int limite = longueurCycle - serpent->longueur;
+    if (rangQueue >= 0 && (rangQueue - rangTete + longueurCycle) % longueurCycle < limite)
+    {
+        limite = (rangQueue - rangTete + longueurCycle) % longueurCycle;
+    }
+    // dernier morceau de serpent (le sien compris) devant la tête avant la limite,
+    // cherché sur au plus PORTEE_CYCLE cases
+    int obstacle = 0;
+    int portee = (limite < PORTEE_CYCLE) ? limite : PORTEE_CYCLE;
+    for (int avance = 1; avance < portee; avance++)
+    {
+        if (partie->occupation[partie->casesCycle[(rangTete + avance) % longueurCycle]] > 0)
+        {
+            obstacle = avance;
+        }
+    }
+    limite -= serpent->aGrandir + MARGE_CYCLE;
+    int rangPomme = partie->rangCycle[CASE(partie->xPomme, partie->yPomme)];
+    int avancePomme = (rangPomme >= 0) ? (rangPomme - rangTete + longueurCycle) % longueurCycle : -1;
+
+    // plus court chemin jusqu'à la pomme s'il tient dans l'avance permise, pomme mangée
+    // et anneaux qu'elle ajoute compris
+    char raccourci = raccourciPomme(partie, numero, limite - partie->croissance);
+    if (raccourci != 0 && !verifierCollisionProchainDeplacement(partie, numero, raccourci))
+    {
+        return raccourci;
+    }
+
+    for (char direction = HAUT; direction <= DROITE; direction++)
+    {
+        positionSuivante(xTete, yTete, direction, &xSuivant, &ySuivant);
+        int rang = partie->rangCycle[CASE(xSuivant, ySuivant)];
+        if (rang < 0 || verifierCollisionProchainDeplacement(partie, numero, direction))
+        {
+            continue;
+        }
+        int avance = (rang - rangTete + longueurCycle) % longueurCycle;
+        if (avance > 1 && avance > limite)
+        {
+            continue;
+        }
+        int distance = partie->distancesPomme[CASE(xSuivant, ySuivant)];
+        int priorite = ((avancePomme < 0 || avance <= avancePomme) ? 2 : 0) + ((avance > obstacle) ? 1 : 0);
+        if (meilleureDirection == 0 || priorite > meilleurePriorite ||
+            (priorite == meilleurePriorite && (distance < meilleureDistance ||
+                                               (distance == meilleureDistance && avance > meilleureAvance))))
+        {
+            meilleureDirection = direction;
+            meilleurePriorite = priorite;
+            meilleureDistance = distance;
+            meilleureAvance = avance;
+        }
+    }
+    if (meilleureDirection == 0)
+    {
+        return directionChampSure(partie, numero, aEtoile);
+    }
+    return meilleureDirection;
+}
+
+char raccourciPomme(tPartie *partie, int numero, int limite)
+{
+    // premier pas du plus court chemin de la tête à la pomme (d'après le champ de distances)
+    // quand ce chemin reste sur le cycle, ne passe sur aucun corps et n'avance en tout que de
+    // limite cases au plus le long du cycle : le serpent peut alors le suivre jusqu'à la pomme
+    // sans dépasser sa queue ; 0 s'il n'y en a pas. À chaque pas, la case qui avance le moins
+    // le long du cycle est prise parmi celles qui rapprochent de la pomme.
+    tSerpent *serpent = &partie->serpents[numero];
+    int longueurCycle = partie->longueurCycle;
+    int x = serpent->lesX[serpent->tete];
+    int y = serpent->lesY[serpent->tete];
+    int rang = partie->rangCycle[CASE(x, y)];
+    int distance = partie->distancesPomme[CASE(x, y)];
+    int total = 0;
+    char premierPas = 0;
+
+    if (distance == DISTANCE_INFINIE)
+    {
+        return 0;
+    }
+    while (distance > 0)
+    {
+        char pas = 0;
+        int avancePas = 0, xPas = 0, yPas = 0, xSuivant, ySuivant;
+        for (char direction = HAUT; direction <= DROITE; direction++)
+        {
+            positionSuivante(x, y, direction, &xSuivant, &ySuivant);
+            int c = CASE(xSuivant, ySuivant);
+            if (partie->distancesPomme[c] != distance - 1 || partie->rangCycle[c] < 0 || partie->occupation[c] > 0)
+            {
+                continue;
+            }
+            int avance = (partie->rangCycle[c] - rang + longueurCycle) % longueurCycle;
+            if (pas == 0 || avance < avancePas)
+            {
+                pas = direction;
+                avancePas = avance;
+                xPas = xSuivant;
+                yPas = ySuivant;
+            }
+        }
+        total += avancePas;
+        if (pas == 0 || total > limite)
+        {
+            return 0;
+        }
+        premierPas = (premierPas == 0) ? pas : premierPas;
+        x = xPas;
+        y = yPas;
+        rang = partie->rangCycle[CASE(x, y)];
+        distance--;
+    }
+    return premierPas;
+}
+
+char directionChampSure(tPartie *partie, int numero, tAEtoile *aEtoile)
+{
+    // stratégie champ parmi les directions sans collision qui laissent au corps assez de place
+    // ou d'où la queue reste accessible (voir mesurerEspace) ; sans direction sûre,
+    // celle qui laisse le plus de place
+    tSerpent *serpent = &partie->serpents[numero];
+    int xTete = serpent->lesX[serpent->tete];
+    int yTete = serpent->lesY[serpent->tete];
+    int borne = serpent->longueur + serpent->aGrandir;
+    char meilleureDirection = serpent->direction;
+    bool meilleureSure = false;
+    int meilleureDistance = DISTANCE_INFINIE, meilleurEspace = -1;
+    int xSuivant, ySuivant;
+
+    if (!partie->champAJour)
+    {
+        calculerChampDistances(partie, partie->xPomme, partie->yPomme);
+        partie->champAJour = true;
+    }
+    preparerRemplissage(aEtoile);
+    for (char direction = HAUT; direction <= DROITE; direction++)
+    {
+        if (verifierCollisionProchainDeplacement(partie, numero, direction))
+        {
+            continue;
+        }
+        bool queueAtteinte;
+        positionSuivante(xTete, yTete, direction, &xSuivant, &ySuivant);
+        int espace = mesurerEspace(partie, numero, xSuivant, ySuivant, borne, aEtoile, &queueAtteinte);
+        bool sure = queueAtteinte || espace >= borne;
+        int distance = partie->distancesPomme[CASE(xSuivant, ySuivant)];
+        bool meilleure;
+        if (sure != meilleureSure)
+        {
+            meilleure = sure;
+        }
+        else if (sure)
+        {
+            meilleure = distance < meilleureDistance ||
+                        (distance == meilleureDistance && direction == serpent->direction);
+        }
+        else
+        {
+            meilleure = espace > meilleurEspace;
+        }
+        if (meilleure)
+        {
+            meilleureDirection = direction;
+            meilleureSure = sure;
+            meilleureDistance = distance;
+            meilleurEspace = espace;
+        }
+    }
+    return meilleureDirection;
+}
+
+/************************************************
+		DISTANCES ENTRE LES CASES LIBRES
+*************************************************/
+void preparerDistances(tPartie *partie)
+{
+    // calcule la table des distances entre cases libres de la carte courante si un serpent
+    // joue une stratégie qui l'interroge (mcts, alphabeta) et que la table en mémoire
+    // a été faite pour une autre disposition des pavés
+    bool utilise = false;
+    for (int i = 0; i < partie->nbSerpents; i++)
+    {
+        utilise = utilise || partie->serpents[i].strategie == STRATEGIE_MCTS ||
+                  partie->serpents[i].strategie == STRATEGIE_ALPHABETA;
+    }
+    if (!utilise)
+    {
+        return;
+    }
+    if (partie->distancesCalculees &&
+        memcmp(partie->distancesPavesX, partie->lesPavesX, sizeof(partie->distancesPavesX)) == 0 &&
+        memcmp(partie->distancesPavesY, partie->lesPavesY, sizeof(partie->distancesPavesY)) == 0)
+    {
+        return;
+    }
+    // reprise du cache si elle y est, sinon calculée puis ajoutée au cache
+    libererDistances(partie);
+    if (!chargerDistances(partie))
+    {
+        calculerDistancesPaires(partie);
+        if (partie->distancesPaires != NULL)
+        {
+            ecrireCache(partie, CACHE_DISTANCES, partie->nbLibres, partie->indiceLibre, NB_CASES * sizeof(int),
+                        partie->distancesPaires, tailleDonneesCache(CACHE_DISTANCES, partie->nbLibres) - NB_CASES * sizeof(int));
+        }
+    }
+    memcpy(partie->distancesPavesX, partie->lesPavesX, sizeof(partie->distancesPavesX));
+    memcpy(partie->distancesPavesY, partie->lesPavesY, sizeof(partie->distancesPavesY));
+    partie->distancesCalculees = true;
+}
+
+void calculerDistancesPaires(tPartie *partie)
+{
+    // numérote les cases libres (ni bordure ni pavé, issues comprises) puis fait un parcours
+    // en largeur depuis chacune, en ne gardant que les distances vers les cases de numéro
+    // inférieur ou égal (l'autre moitié s'en déduit, les issues se franchissant dans les deux
+    // sens) ; au-delà de NB_LIBRES_MAX_DISTANCES cases libres, la table n'est pas construite
+    // et distanceCases se contente d'un minorant. Les voisins de chaque case libre sont
+    // d'abord relevés une fois pour toutes (par leur numéro, -1 pour une case bloquée).
+    int *voisins;
+    int *file;
+    uint16_t *distances;
+    int xVoisin, yVoisin;
+
+    libererDistances(partie);
+    partie->indiceLibre = allouerMemoire(NB_CASES * sizeof(int));
+    for (size_t c = 0; c < NB_CASES; c++)
+    {
+        partie->indiceLibre[c] = -1;
+    }
+    for (int y = 1; y <= hauteurPlateau; y++)
+    {
+        for (int x = 1; x <= largeurPlateau; x++)
+        {
+            if (partie->plateau[CASE(x, y)] != BORDURE)
+            {
+                partie->indiceLibre[CASE(x, y)] = partie->nbLibres++;
+            }
+        }
+    }
+    if (partie->nbLibres > NB_LIBRES_MAX_DISTANCES)
+    {
+        return;
+    }
+
+    int n = partie->nbLibres;
+    size_t taille = (size_t)n * (n + 1) / 2;
+    partie->distancesPaires = allouerMemoire(taille * sizeof(uint16_t));
+    memset(partie->distancesPaires, 0xff, taille * sizeof(uint16_t));
+    voisins = allouerMemoire((size_t)n * 4 * sizeof(int));
+    file = allouerMemoire(n * sizeof(int));
+    distances = allouerMemoire(n * sizeof(uint16_t));
+    for (size_t c = 0; c < NB_CASES; c++)
+    {
+        int i = partie->indiceLibre[c];
+        if (i < 0)
+        {
+            continue;
+        }
+        for (char direction = HAUT; direction <= DROITE; direction++)
+        {
+            positionSuivante(CASE_X(c), CASE_Y(c), direction, &xVoisin, &yVoisin);
+            voisins[4 * i + direction - HAUT] = partie->indiceLibre[CASE(xVoisin, yVoisin)];
+        }
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        uint16_t *ligne = &partie->distancesPaires[(size_t)i * (i + 1) / 2];
+        int debut = 0, fin = 0;
+        memset(distances, 0xff, n * sizeof(uint16_t));
+        distances[i] = 0;
+        file[fin++] = i;
+        while (debut < fin)
+        {
+            int j = file[debut++];
+            if (j <= i)
+            {
+                ligne[j] = distances[j];
+            }
+            for (int k = 0; k < 4; k++)
+            {
+                int voisin = voisins[4 * j + k];
+                if (voisin >= 0 && distances[voisin] == DISTANCE_INCONNUE)
+                {
+                    distances[voisin] = distances[j] + 1;
+                    file[fin++] = voisin;
+                }
+            }
+        }
+    }
+    free(voisins);
+    free(file);
+    free(distances);
+}
+
+int distanceCases(tPartie *partie, int c1, int c2)
+{
+    // nombre de déplacements entre deux cases en contournant bordures et pavés (corps des
+    // serpents ignorés), issues comprises ; DISTANCE_INFINIE si l'une est bloquée ou si elles
+    // ne communiquent pas. Sans table (carte trop grande ou pas encore calculée), minorant
+    // par le chemin direct ou par deux issues.
+    if (partie->distancesPaires == NULL)
+    {
+        return heuristiqueAEtoile(CASE_X(c1), CASE_Y(c1), CASE_X(c2), CASE_Y(c2),
+                                  distanceIssuLaPlusProche(CASE_X(c2), CASE_Y(c2)));
+    }
+    int i = partie->indiceLibre[c1];
+    int j = partie->indiceLibre[c2];
+    if (i < 0 || j < 0)
+    {
+        return DISTANCE_INFINIE;
+    }
+    if (i < j)
+    {
+        int echange = i;
+        i = j;
+        j = echange;
+    }
+    uint16_t distance = partie->distancesPaires[(size_t)i * (i + 1) / 2 + j];
+    return (distance == DISTANCE_INCONNUE) ? DISTANCE_INFINIE : distance;
+}
+
+/************************************************
+		FONCTIONS DE LA RECHERCHE HIERARCHIQUE
+*************************************************/
+void etapeHpa(tPartie *partie, int numero, tAEtoile *aEtoile, int *xCible, int *yCible)
+{
+    // case vers laquelle le serpent doit se diriger à ce tour : la recherche hiérarchique
+    // donne la prochaine étape du chemin vers la pomme (une entrée de la grappe de la tête,
+    // l'entrée suivante quand la tête y est déjà, ou la pomme elle-même), puis le chemin
+    // jusqu'à cette étape est affiné case par case dans la grappe de la tête et celle de
+    // l'étape seulement, en contournant aussi les corps ; la cible est alors la case voisine
+    // de la tête sur ce chemin (écrite sans repli par les issues, (x, 0) pour monter depuis
+    // l'issue du haut, comme directionSerpent l'attend). Sans chemin affiné, la cible est l'étape.
+    tSerpent *serpent = &partie->serpents[numero];
+    tHpa *hpa = &partie->hpa;
+    int xTete = serpent->lesX[serpent->tete];
+    int yTete = serpent->lesY[serpent->tete];
+    int tete = CASE(xTete, yTete);
+    int pomme = CASE(partie->xPomme, partie->yPomme);
+    int distances[TAILLE_GRAPPE * TAILLE_GRAPPE];
+    int file[TAILLE_GRAPPE * TAILLE_GRAPPE];
+    int etape = pomme;
+    int meilleur = DISTANCE_INFINIE;
+    int xVoisin, yVoisin;
+
+    if (!hpa->calcule)
+    {
+        construireGrapheHpa(partie);
+    }
+    if (!hpa->routeAJour)
+    {
+        calculerRouteHpa(partie);
+    }
+
+    // étape : parmi les entrées de la grappe de la tête qu'elle peut atteindre sans sortir
+    // de la grappe, celle par où le chemin jusqu'à la pomme est le plus court
+    // (ou la pomme directement, si elle est dans la grappe)
+    int grappe = grappeCase(hpa, xTete, yTete);
+    int x0 = 1 + (grappe % hpa->nbGrappesX) * TAILLE_GRAPPE;
+    int y0 = 1 + (grappe / hpa->nbGrappesX) * TAILLE_GRAPPE;
+    parcourirGrappe(partie, xTete, yTete, distances, file);
+    if (grappeCase(hpa, partie->xPomme, partie->yPomme) == grappe &&
+        distances[(partie->yPomme - y0) * TAILLE_GRAPPE + partie->xPomme - x0] >= 0)
+    {
+        meilleur = distances[(partie->yPomme - y0) * TAILLE_GRAPPE + partie->xPomme - x0];
+    }
+    for (int n = hpa->premierNoeud[grappe]; n < hpa->premierNoeud[grappe + 1]; n++)
+    {
+        int c = hpa->caseNoeud[n];
+        int local = distances[(CASE_Y(c) - y0) * TAILLE_GRAPPE + CASE_X(c) - x0];
+        if (local < 0 || hpa->distancePomme[n] == DISTANCE_INFINIE || local + hpa->distancePomme[n] >= meilleur)
+        {
+            continue;
+        }
+        meilleur = local + hpa->distancePomme[n];
+        // la tête est sur l'entrée : l'étape est la suivante sur le chemin
+        int suivant = n;
+        while (suivant >= 0 && hpa->caseNoeud[suivant] == tete)
+        {
+            suivant = hpa->suivant[suivant];
+        }
+        etape = (suivant >= 0) ? hpa->caseNoeud[suivant] : pomme;
+    }
+    *xCible = CASE_X(etape);
+    *yCible = CASE_Y(etape);
+    if (etape == tete)
+    {
+        return;
+    }
+
+    // affinage : parcours en largeur depuis la tête dans les grappes de la tête et de l'étape,
+    // issues comprises, en évitant les corps (sauf les queues, qui partiront)
+    int grappeEtape = grappeCase(hpa, CASE_X(etape), CASE_Y(etape));
+    int debut = 0, fin = 0;
+    nouvelleRechercheAEtoile(aEtoile);
+    aEtoile->marque[tete] = aEtoile->numeroRecherche;
+    aEtoile->g[fin++] = tete;
+    while (debut < fin)
+    {
+        int c = aEtoile->g[debut++];
+        for (char direction = HAUT; direction <= DROITE; direction++)
+        {
+            positionSuivante(CASE_X(c), CASE_Y(c), direction, &xVoisin, &yVoisin);
+            int voisin = CASE(xVoisin, yVoisin);
+            int grappeVoisin = grappeCase(hpa, xVoisin, yVoisin);
+            if (aEtoile->marque[voisin] == aEtoile->numeroRecherche ||
+                (grappeVoisin != grappe && grappeVoisin != grappeEtape) ||
+                partie->plateau[voisin] == BORDURE ||
+                (partie->occupation[voisin] > 0 && !testerBit(&partie->queues, xVoisin, yVoisin)))
+            {
+                continue;
+            }
+            aEtoile->marque[voisin] = aEtoile->numeroRecherche;
+            // direction du premier pas depuis la tête, transmise le long du parcours
+            aEtoile->arrivee[voisin] = (c == tete) ? direction : aEtoile->arrivee[c];
+            if (voisin == etape)
+            {
+                const int PAS_X[] = {0, 0, 0, -1, 1};
+                const int PAS_Y[] = {0, -1, 1, 0, 0};
+                *xCible = xTete + PAS_X[(int)aEtoile->arrivee[voisin]];
+                *yCible = yTete + PAS_Y[(int)aEtoile->arrivee[voisin]];
+                return;
+            }
+            aEtoile->g[fin++] = voisin;
+        }
+    }
+}
+
+int grappeCase(const tHpa *hpa, int x, int y)
+{
+    return ((y - 1) / TAILLE_GRAPPE) * hpa->nbGrappesX + (x - 1) / TAILLE_GRAPPE;
+}
+
+void parcourirGrappe(tPartie *partie, int x, int y, int *distances, int *file)
+{
+    // parcours en largeur depuis (x, y) sans sortir de sa grappe, bordures et pavés contournés
+    // (corps ignorés, issues non franchies) : distances[(y - y0) * TAILLE_GRAPPE + x - x0]
+    // reçoit la distance de chaque case de la grappe de coin supérieur gauche (x0, y0),
+    // -1 si elle est inaccessible ; file sert de file du parcours (TAILLE_GRAPPE² cases)
+    int x0 = 1 + ((x - 1) / TAILLE_GRAPPE) * TAILLE_GRAPPE;
+    int y0 = 1 + ((y - 1) / TAILLE_GRAPPE) * TAILLE_GRAPPE;
+    int x1 = (x0 + TAILLE_GRAPPE - 1 < largeurPlateau) ? x0 + TAILLE_GRAPPE - 1 : largeurPlateau;
+    int y1 = (y0 + TAILLE_GRAPPE - 1 < hauteurPlateau) ? y0 + TAILLE_GRAPPE - 1 : hauteurPlateau;
+    const int PAS_X[4] = {0, 0, -1, 1};
+    const int PAS_Y[4] = {-1, 1, 0, 0};
+    int debut = 0, fin = 0;
+
+    for (int i = 0; i < TAILLE_GRAPPE * TAILLE_GRAPPE; i++)
+    {
+        distances[i] = -1;
+    }
+    distances[(y - y0) * TAILLE_GRAPPE + x - x0] = 0;
+    file[fin++] = (y - y0) * TAILLE_GRAPPE + x - x0;
+    while (debut < fin)
+    {
+        int local = file[debut++];
+        int xc = x0 + local % TAILLE_GRAPPE, yc = y0 + local / TAILLE_GRAPPE;
+        for (int k = 0; k < 4; k++)
+        {
+            int xv = xc + PAS_X[k], yv = yc + PAS_Y[k];
+            int voisin = (yv - y0) * TAILLE_GRAPPE + xv - x0;
+            if (xv < x0 || xv > x1 || yv < y0 || yv > y1 || distances[voisin] >= 0 ||
+                partie->plateau[CASE(xv, yv)] == BORDURE)
+            {
+                continue;
+            }
+            distances[voisin] = distances[local] + 1;
+            file[fin++] = voisin;
+        }
+    }
+}
+
+void preparerGrapheHpa(tPartie *partie)
+{
+    // construit le graphe abstrait de la carte courante si un serpent joue la stratégie
+    // heuristique et que le graphe en mémoire a été fait pour une autre disposition des pavés
+    bool utilise = false;
+    for (int i = 0; i < partie->nbSerpents; i++)
+    {
+        utilise = utilise || partie->serpents[i].strategie == STRATEGIE_HEURISTIQUE;
+    }
+    if (!utilise)
+    {
+        return;
+    }
+    if (partie->hpa.calcule &&
+        memcmp(partie->hpa.pavesX, partie->lesPavesX, sizeof(partie->hpa.pavesX)) == 0 &&
+        memcmp(partie->hpa.pavesY, partie->lesPavesY, sizeof(partie->hpa.pavesY)) == 0)
+    {
+        return;
+    }
+    construireGrapheHpa(partie);
+}
+
+void construireGrapheHpa(tPartie *partie)
+{
+    // noeuds : les deux cases de chaque passage entre grappes voisines et de chaque issue
+    // (relevés par relierGrappesHpa), rangés grappe par grappe ; arêtes : le passage lui-même
+    // (coût 1) et, dans chaque grappe, les plus courts chemins entre ses noeuds
+    tHpa *hpa = &partie->hpa;
+    int distances[TAILLE_GRAPPE * TAILLE_GRAPPE];
+    int file[TAILLE_GRAPPE * TAILLE_GRAPPE];
+
+    libererHpa(hpa);
+    hpa->nbGrappesX = (largeurPlateau + TAILLE_GRAPPE - 1) / TAILLE_GRAPPE;
+    hpa->nbGrappesY = (hauteurPlateau + TAILLE_GRAPPE - 1) / TAILLE_GRAPPE;
+    int nbGrappes = hpa->nbGrappesX * hpa->nbGrappesY;
+    int nbPassages = relierGrappesHpa(partie, NULL);
+    int *cases = allouerMemoire((2 * nbPassages + 1) * sizeof(int));
+    int *rang = allouerMemoire((2 * nbPassages + 1) * sizeof(int));
+    relierGrappesHpa(partie, cases);
+    hpa->nbNoeuds = 2 * nbPassages;
+
+    // tri des noeuds par grappe (le noeud 2k du passage k devient rang[2k])
+    hpa->premierNoeud = allouerMemoire((nbGrappes + 1) * sizeof(int));
+    memset(hpa->premierNoeud, 0, (nbGrappes + 1) * sizeof(int));
+    for (int n = 0; n < hpa->nbNoeuds; n++)
+    {
+        hpa->premierNoeud[grappeCase(hpa, CASE_X(cases[n]), CASE_Y(cases[n])) + 1]++;
+    }
+    for (int g = 0; g < nbGrappes; g++)
+    {
+        hpa->premierNoeud[g + 1] += hpa->premierNoeud[g];
+    }
+    hpa->caseNoeud = allouerMemoire((hpa->nbNoeuds + 1) * sizeof(int));
+    for (int n = 0; n < hpa->nbNoeuds; n++)
+    {
+        int g = grappeCase(hpa, CASE_X(cases[n]), CASE_Y(cases[n]));
+        rang[n] = hpa->premierNoeud[g]++;
+        hpa->caseNoeud[rang[n]] = cases[n];
+    }
+    for (int g = nbGrappes; g > 0; g--)
+    {
+        hpa->premierNoeud[g] = hpa->premierNoeud[g - 1];
+    }
+    hpa->premierNoeud[0] = 0;
+
+    // arêtes de chaque noeud à la suite : son passage, puis les noeuds de sa grappe
+    // qu'il atteint sans en sortir ; partenaire[rang] est l'autre bout du passage
+    int *partenaire = cases;
+    for (int k = 0; k < nbPassages; k++)
+    {
+        partenaire[rang[2 * k]] = rang[2 * k + 1];
+        partenaire[rang[2 * k + 1]] = rang[2 * k];
+    }
+    int capaciteAretes = 4 * hpa->nbNoeuds + 16;
+    int nbAretes = 0;
+    hpa->aretes = allouerMemoire(capaciteAretes * sizeof(tAreteHpa));
+    hpa->premiereArete = allouerMemoire((hpa->nbNoeuds + 1) * sizeof(int));
+    for (int g = 0; g < nbGrappes; g++)
+    {
+        int x0 = 1 + (g % hpa->nbGrappesX) * TAILLE_GRAPPE;
+        int y0 = 1 + (g / hpa->nbGrappesX) * TAILLE_GRAPPE;
+        for (int n = hpa->premierNoeud[g]; n < hpa->premierNoeud[g + 1]; n++)
+        {
+            hpa->premiereArete[n] = nbAretes;
+            parcourirGrappe(partie, CASE_X(hpa->caseNoeud[n]), CASE_Y(hpa->caseNoeud[n]), distances, file);
+            for (int m = hpa->premierNoeud[g] - 1; m < hpa->premierNoeud[g + 1]; m++)
+            {
+                // m = premierNoeud[g] - 1 désigne le partenaire du noeud
+                int arrivee = (m < hpa->premierNoeud[g]) ? partenaire[n] : m;
+                int cout = 1;
+                if (m >= hpa->premierNoeud[g])
+                {
+                    int c = hpa->caseNoeud[m];
+                    cout = distances[(CASE_Y(c) - y0) * TAILLE_GRAPPE + CASE_X(c) - x0];
+                    if (m == n || cout < 0)
+                    {
+                        continue;
+                    }
+                }
+                if (nbAretes == capaciteAretes)
+                {
+                    capaciteAretes *= 2;
+                    hpa->aretes = realloc(hpa->aretes, capaciteAretes * sizeof(tAreteHpa));
+                    if (hpa->aretes == NULL)
+                    {
+                        perror("realloc");
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                hpa->aretes[nbAretes].arrivee = arrivee;
+                hpa->aretes[nbAretes].cout = cout;
+                nbAretes++;
+            }
+        }
+    }
+    hpa->premiereArete[hpa->nbNoeuds] = nbAretes;
+    free(cases);
+    free(rang);
+
+    hpa->distancePomme = allouerMemoire((hpa->nbNoeuds + 1) * sizeof(int));
+    hpa->suivant = allouerMemoire((hpa->nbNoeuds + 1) * sizeof(int));
+    hpa->capaciteTas = nbAretes + hpa->nbNoeuds + 1;
+    hpa->tas = allouerMemoire(hpa->capaciteTas * sizeof(tPaireHpa));
+    memcpy(hpa->pavesX, partie->lesPavesX, sizeof(hpa->pavesX));
+    memcpy(hpa->pavesY, partie->lesPavesY, sizeof(hpa->pavesY));
+    hpa->calcule = true;
+    hpa->routeAJour = false;
+}
+
+int relierGrappesHpa(tPartie *partie, int *cases)
+{
+    // relève les passages du graphe abstrait et retourne leur nombre ; si cases n'est pas NULL,
+    // les deux cases du passage k y sont écrites aux indices 2k et 2k + 1. Le long de la frontière
+    // entre deux grappes voisines, chaque suite de cases libres des deux côtés donne un passage
+    // en son milieu, ou deux à ses extrémités si elle fait au moins ENTREE_LONGUE cases ;
+    // chaque paire d'issues opposées donne aussi un passage
+    int nbPassages = 0;
+    for (int sens = 0; sens < 2; sens++)
+    {
+        // sens 0 : frontières verticales (entre colonnes x et x + 1), sens 1 : horizontales
+        int longueurFrontiere = (sens == 0) ? hauteurPlateau : largeurPlateau;
+        int limite = (sens == 0) ? largeurPlateau : hauteurPlateau;
+        for (int f = TAILLE_GRAPPE; f < limite; f += TAILLE_GRAPPE)
+        {
+            int debutSuite = -1;
+            for (int i = 1; i <= longueurFrontiere + 1; i++)
+            {
+                bool libre = false;
+                if (i <= longueurFrontiere)
+                {
+                    int a = (sens == 0) ? CASE(f, i) : CASE(i, f);
+                    int b = (sens == 0) ? CASE(f + 1, i) : CASE(i, f + 1);
+                    libre = partie->plateau[a] != BORDURE && partie->plateau[b] != BORDURE;
+                }
+                // une suite s'arrête sur une case bloquée ou à la frontière d'une grappe
+                bool coupure = !libre || (i - 1) % TAILLE_GRAPPE == 0;
+                if (debutSuite >= 0 && coupure)
+                {
+                    int finSuite = i - 1;
+                    int positions[2] = {(debutSuite + finSuite) / 2, -1};
+                    if (finSuite - debutSuite + 1 >= ENTREE_LONGUE)
+                    {
+                        positions[0] = debutSuite;
+                        positions[1] = finSuite;
+                    }
+                    for (int p = 0; p < 2 && positions[p] >= 0; p++)
+                    {
+                        if (cases != NULL)
+                        {
+                            int j = positions[p];
+                            cases[2 * nbPassages] = (sens == 0) ? CASE(f, j) : CASE(j, f);
+                            cases[2 * nbPassages + 1] = (sens == 0) ? CASE(f + 1, j) : CASE(j, f + 1);
+                        }
+                        nbPassages++;
+                    }
+                    debutSuite = -1;
+                }
+                if (libre && debutSuite < 0)
+                {
+                    debutSuite = i;
+                }
+            }
+        }
+    }
+    if (cases != NULL)
+    {
+        cases[2 * nbPassages] = CASE(xIssues, 1);
+        cases[2 * nbPassages + 1] = CASE(xIssues, hauteurPlateau);
+        cases[2 * nbPassages + 2] = CASE(1, yIssues);
+        cases[2 * nbPassages + 3] = CASE(largeurPlateau, yIssues);
+    }
+    return nbPassages + 2;
+}
+
+void preparerRouteHpa(tPartie *partie)
+{
+    // calcule la route vers la pomme courante si elle ne l'est pas encore et qu'un serpent
+    // encore en jeu joue la stratégie heuristique (avant que les threads ne la lisent)
+    if (!partie->hpa.calcule || partie->hpa.routeAJour)
+    {
+        return;
+    }
+    for (int i = 0; i < partie->nbSerpents; i++)
+    {
+        if (!partie->serpents[i].collision && partie->serpents[i].strategie == STRATEGIE_HEURISTIQUE)
+        {
+            calculerRouteHpa(partie);
+            return;
+        }
+    }
+}
+
+void calculerRouteHpa(tPartie *partie)
+{
+    // algorithme de Dijkstra sur le graphe abstrait, depuis la pomme : les noeuds de sa grappe
+    // qui l'atteignent sans en sortir partent de cette distance (suivant -1 : la pomme est
+    // l'étape d'après) ; les autres reçoivent leur distance à la pomme et le noeud suivant
+    // sur le plus court chemin (le graphe est symétrique)
+    tHpa *hpa = &partie->hpa;
+    int distances[TAILLE_GRAPPE * TAILLE_GRAPPE];
+    int file[TAILLE_GRAPPE * TAILLE_GRAPPE];
+    int grappe = grappeCase(hpa, partie->xPomme, partie->yPomme);
+    int x0 = 1 + (grappe % hpa->nbGrappesX) * TAILLE_GRAPPE;
+    int y0 = 1 + (grappe / hpa->nbGrappesX) * TAILLE_GRAPPE;
+
+    for (int n = 0; n < hpa->nbNoeuds; n++)
+    {
+        hpa->distancePomme[n] = DISTANCE_INFINIE;
+        hpa->suivant[n] = -1;
+    }
+    hpa->tailleTas = 0;
+    parcourirGrappe(partie, partie->xPomme, partie->yPomme, distances, file);
+    for (int n = hpa->premierNoeud[grappe]; n < hpa->premierNoeud[grappe + 1]; n++)
+    {
+        int c = hpa->caseNoeud[n];
+        int distance = distances[(CASE_Y(c) - y0) * TAILLE_GRAPPE + CASE_X(c) - x0];
+        if (distance >= 0)
+        {
+            hpa->distancePomme[n] = distance;
+            insererTasHpa(hpa, distance, n);
+        }
+    }
+    while (hpa->tailleTas > 0)
+    {
+        tPaireHpa paire = extraireTasHpa(hpa);
+        if (paire.distance > hpa->distancePomme[paire.noeud])
+        {
+            continue; // entrée périmée du tas
+        }
+        for (int a = hpa->premiereArete[paire.noeud]; a < hpa->premiereArete[paire.noeud + 1]; a++)
+        {
+            int voisin = hpa->aretes[a].arrivee;
+            int distance = paire.distance + hpa->aretes[a].cout;
+            if (distance < hpa->distancePomme[voisin])
+            {
+                hpa->distancePomme[voisin] = distance;
+                hpa->suivant[voisin] = paire.noeud;
+                insererTasHpa(hpa, distance, voisin);
+            }
+        }
+    }
+    hpa->routeAJour = true;
+}
+
+void insererTasHpa(tHpa *hpa, int distance, int noeud)
+{
+    // tas binaire minimum sur la distance (il a une place par arête et par noeud de départ,
+    // une entrée au plus par amélioration d'une distance)
+    int i = hpa->tailleTas++;
+    while (i > 0 && hpa->tas[(i - 1) / 2].distance > distance)
+    {
+        hpa->tas[i] = hpa->tas[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    hpa->tas[i].distance = distance;
+    hpa->tas[i].noeud = noeud;
+}
+
+tPaireHpa extraireTasHpa(tHpa *hpa)
+{
+    tPaireHpa racine = hpa->tas[0];
+    tPaireHpa dernier = hpa->tas[--hpa->tailleTas];
+    int i = 0;
+    while (2 * i + 1 < hpa->tailleTas)
+    {
+        int fils = 2 * i + 1;
+        if (fils + 1 < hpa->tailleTas && hpa->tas[fils + 1].distance < hpa->tas[fils].distance)
+        {
+            fils++;
+        }
+        if (dernier.distance <= hpa->tas[fils].distance)
+        {
+            break;
+        }
+        hpa->tas[i] = hpa->tas[fils];
+        i = fils;
+    }
+    hpa->tas[i] = dernier;
+    return racine;
+}
+
+void libererHpa(tHpa *hpa)
+{
+    free(hpa->caseNoeud);
+    free(hpa->premierNoeud);
+    free(hpa->premiereArete);
+    free(hpa->aretes);
+    free(hpa->distancePomme);
+    free(hpa->suivant);
+    free(hpa->tas);
+    hpa->caseNoeud = NULL;
+    hpa->premierNoeud = NULL;
+    hpa->premiereArete = NULL;
+    hpa->aretes = NULL;
+    hpa->distancePomme = NULL;
+    hpa->suivant = NULL;
+    hpa->tas = NULL;
+    hpa->nbNoeuds = 0;
+    hpa->calcule = false;
+}
+
+/************************************************
+		CACHE DES TABLES DE LA CARTE
+*************************************************/
+bool chargerCycle(tPartie *partie)
+{
+    // projette en mémoire le cycle hamiltonien de la carte courante depuis le cache,
+    // s'il y est ; les tableaux pointent alors dans la projection, en lecture seule
+    int nombre;
+    char *donnees = projeterCache(partie, CACHE_CYCLE, &nombre, &partie->projectionCycle,
+                                  &partie->tailleProjectionCycle);
+    if (donnees == NULL)
+    {
+        return false;
+    }
+    partie->rangCycle = (int *)donnees;
+    partie->casesCycle = partie->rangCycle + NB_CASES;
+    partie->longueurCycle = nombre;
+    return true;
+}
+
+bool chargerDistances(tPartie *partie)
+{
+    // projette en mémoire la table des distances de la carte courante depuis le cache,
+    // s'il y est ; les tableaux pointent alors dans la projection, en lecture seule
+    int nombre;
+    char *donnees = projeterCache(partie, CACHE_DISTANCES, &nombre, &partie->projectionDistances,
+                                  &partie->tailleProjectionDistances);
+    if (donnees == NULL)
+    {
+        return false;
+    }
+    partie->indiceLibre = (int *)donnees;
+    partie->distancesPaires = (uint16_t *)(partie->indiceLibre + NB_CASES);
+    partie->nbLibres = nombre;
+    return true;
+}
+
+void libererCycle(tPartie *partie)
+{
+    // rend le cycle hamiltonien en mémoire, calculé ou projeté depuis le cache
+    if (partie->projectionCycle != NULL)
+    {
+        munmap(partie->projectionCycle, partie->tailleProjectionCycle);
+        partie->projectionCycle = NULL;
+    }
+    else
+    {
+        free(partie->rangCycle);
+        free(partie->casesCycle);
+    }
+    partie->rangCycle = NULL;
+    partie->casesCycle = NULL;
+    partie->longueurCycle = 0;
+}
+
+void libererDistances(tPartie *partie)
+{
+    // rend la table des distances en mémoire, calculée ou projetée depuis le cache
+    if (partie->projectionDistances != NULL)
+    {
+        munmap(partie->projectionDistances, partie->tailleProjectionDistances);
+        partie->projectionDistances = NULL;
+    }
+    else
+    {
+        free(partie->distancesPaires);
+        free(partie->indiceLibre);
+    }
+    partie->distancesPaires = NULL;
+    partie->indiceLibre = NULL;
+    partie->nbLibres = 0;
+}
+
+size_t tailleDonneesCache(int contenu, int nombre)
+{
+    // taille des tableaux qui suivent l'en-tête d'un fichier du cache : numéro de chaque case
+    // libre puis distances entre paires, ou rang de chaque case puis cases du cycle
+    if (contenu == CACHE_DISTANCES)
+    {
+        return NB_CASES * sizeof(int) + (size_t)nombre * (nombre + 1) / 2 * sizeof(uint16_t);
+    }
+    return NB_CASES * sizeof(int) + (size_t)nombre * sizeof(int);
+}
+
+void remplirEnteteCache(tPartie *partie, int contenu, int nombre, tEnteteCache *entete)
+{
+    // en-tête attendu pour la carte courante (mis à zéro d'abord, octets de bourrage compris,
+    // pour que deux en-têtes se comparent d'un bloc)
+    memset(entete, 0, sizeof(*entete));
+    memcpy(entete->magie, MAGIE_CACHE, sizeof(entete->magie));
+    entete->version = VERSION_CACHE;
+    entete->contenu = contenu;
+    entete->tailleEntier = sizeof(int);
+    entete->largeur = largeurPlateau;
+    entete->hauteur = hauteurPlateau;
+    entete->xIssues = xIssues;
+    entete->yIssues = yIssues;
+    entete->taillePaves = taillePaves;
+    for (int i = 0; i < NB_PAVES; i++)
+    {
+        entete->pavesX[i] = partie->lesPavesX[i];
+        entete->pavesY[i] = partie->lesPavesY[i];
+    }
+    entete->nombre = nombre;
+    entete->cle = cleCarte(partie);
+}
+
+void nomFichierCache(tPartie *partie, int contenu, char *nom, size_t taille)
+{
+    snprintf(nom, taille, "%s/%s-%016llx.bin", repertoireCache, NOMS_CACHE[contenu],
+             (unsigned long long)cleCarte(partie));
+}
+
+char *projeterCache(tPartie *partie, int contenu, int *nombre, void **projection, size_t *taille)
+{
+    // projette en lecture seule le fichier du cache de cette carte pour ce contenu et retourne
+    // l'adresse des tableaux qui suivent l'en-tête, ou NULL si le cache n'est pas utilisé,
+    // si le fichier n'existe pas ou s'il ne correspond pas exactement à la carte (version,
+    // dimensions, issues, pavés, taille) ; la projection est partagée avec les autres
+    // processus qui lisent le même fichier
+    char nom[PATH_MAX];
+    struct stat etat;
+    tEnteteCache attendu;
+
+    if (repertoireCache == NULL)
+    {
+        return NULL;
+    }
+    nomFichierCache(partie, contenu, nom, sizeof(nom));
+    int fd = open(nom, O_RDONLY);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    if (fstat(fd, &etat) != 0 || (size_t)etat.st_size < sizeof(tEnteteCache))
+    {
+        close(fd);
+        return NULL;
+    }
+    void *adresse = mmap(NULL, etat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    // le fichier vient d'être utilisé : il passe après les autres dans l'ordre de suppression
+    // de limiterCache (sans conséquence si sa date ne peut pas être changée)
+    futimens(fd, NULL);
+    close(fd);
+    if (adresse == MAP_FAILED)
+    {
+        return NULL;
+    }
+    const tEnteteCache *entete = adresse;
+    remplirEnteteCache(partie, contenu, entete->nombre, &attendu);
+    if (entete->nombre < 0 || memcmp(entete, &attendu, sizeof(attendu)) != 0 ||
+        (size_t)etat.st_size != sizeof(tEnteteCache) + tailleDonneesCache(contenu, entete->nombre))
+    {
+        munmap(adresse, etat.st_size);
+        return NULL;
+    }
+    *nombre = entete->nombre;
+    *projection = adresse;
+    *taille = etat.st_size;
+    return (char *)adresse + sizeof(tEnteteCache);
+}
+
+void ecrireCache(tPartie *partie, int contenu, int nombre, const void *tableau1, size_t taille1,
+                 const void *tableau2, size_t taille2)
+{
+    // écrit l'en-tête et les deux tableaux dans un fichier temporaire du répertoire du cache,
+    // puis le renomme : un autre processus ne voit jamais de fichier à moitié écrit, et
+    // deux processus qui calculent la même carte en même temps écrivent le même contenu
+    char nom[PATH_MAX];
+    char temporaire[PATH_MAX + 8];
+    tEnteteCache entete;
+
+    if (repertoireCache == NULL)
+    {
+        return;
+    }
+    limiterCache(sizeof(entete) + taille1 + taille2);
+    nomFichierCache(partie, contenu, nom, sizeof(nom));
+    snprintf(temporaire, sizeof(temporaire), "%s.XXXXXX", nom);
+    int fd = mkstemp(temporaire);
+    if (fd < 0)
+    {
+        perror(temporaire);
+        return;
+    }
+    FILE *fichier = fdopen(fd, "wb");
+    if (fichier == NULL)
+    {
+        perror(temporaire);
+        close(fd);
+        unlink(temporaire);
+        return;
+    }
+    remplirEnteteCache(partie, contenu, nombre, &entete);
+    bool ecrit = fwrite(&entete, sizeof(entete), 1, fichier) == 1 &&
+                 fwrite(tableau1, 1, taille1, fichier) == taille1 &&
+                 fwrite(tableau2, 1, taille2, fichier) == taille2;
+    if (fclose(fichier) != 0 || !ecrit || rename(temporaire, nom) != 0)
+    {
+        perror(nom);
+        unlink(temporaire);
+    }
+}
+
+void limiterCache(size_t tailleAjoutee)
+{
+    // supprime les fichiers du cache les moins récemment utilisés (date de modification la plus
+    // ancienne) jusqu'à ce que le fichier à écrire tienne dans TAILLE_MAX_CACHE octets avec
+    // les autres ; seuls les fichiers nommés comme ceux du cache sont comptés et supprimés
+    // (un fichier supprimé reste lisible par les processus qui l'ont déjà projeté)
+    DIR *repertoire = opendir(repertoireCache);
+    struct dirent *entree;
+    tFichierCache *fichiers = NULL;
+    int nbFichiers = 0, capacite = 0;
+    long long total = 0;
+
+    if (repertoire == NULL)
+    {
+        return;
+    }
+    while ((entree = readdir(repertoire)) != NULL)
+    {
+        size_t longueur = strlen(entree->d_name);
+        bool duCache = false;
+        for (int c = 0; c < NB_CONTENUS_CACHE; c++)
+        {
+            size_t prefixe = strlen(NOMS_CACHE[c]);
+            duCache = duCache || (strncmp(entree->d_name, NOMS_CACHE[c], prefixe) == 0 &&
+                                  entree->d_name[prefixe] == '-' && longueur > 4 &&
+                                  strcmp(entree->d_name + longueur - 4, ".bin") == 0);
+        }
+        if (!duCache)
+        {
+            continue;
+        }
+        if (nbFichiers == capacite)
+        {
+            capacite = (capacite == 0) ? 64 : 2 * capacite;
+            fichiers = realloc(fichiers, capacite * sizeof(tFichierCache));
+            if (fichiers == NULL)
+            {
+                perror("realloc");
+                exit(EXIT_FAILURE);
+            }
+        }
+        tFichierCache *fichier = &fichiers[nbFichiers];
+        struct stat etat;
+        snprintf(fichier->nom, sizeof(fichier->nom), "%s/%s", repertoireCache, entree->d_name);
+        if (stat(fichier->nom, &etat) != 0 || !S_ISREG(etat.st_mode))
+        {
+            continue;
+        }
+        fichier->taille = etat.st_size;
+        fichier->date = etat.st_mtime;
+        total += etat.st_size;
+        nbFichiers++;
+    }
+    closedir(repertoire);
+
+    qsort(fichiers, nbFichiers, sizeof(tFichierCache), comparerFichiersCache);
+    for (int i = 0; i < nbFichiers && total + (long long)tailleAjoutee > TAILLE_MAX_CACHE; i++)
+    {
+        // un autre processus a pu le supprimer entre-temps
+        if (unlink(fichiers[i].nom) == 0 || errno == ENOENT)
+        {
+            total -= fichiers[i].taille;
+        }
+    }
+    free(fichiers);
+}
+
+int comparerFichiersCache(const void *a, const void *b)
+{
+    // du moins récemment utilisé au plus récent
+    time_t dateA = ((const tFichierCache *)a)->date;
+    time_t dateB = ((const tFichierCache *)b)->date;
+    return (dateA > dateB) - (dateA < dateB);
+}
+
+uint64_t cleCarte(tPartie *partie)
+{
+    // clé de la carte : dimensions, issues, taille et position des pavés ; sert au nom des
+    // fichiers du cache et aux clés de Zobrist de la stratégie alphabeta (la table de
+    // transposition sert d'une partie à l'autre, une position d'une autre carte ne doit
+    // pas y être reconnue)
+    uint64_t cle = melanger64((uint64_t)largeurPlateau << 48 | (uint64_t)hauteurPlateau << 32 |
+                              (uint64_t)xIssues << 16 | (uint64_t)yIssues);
+    cle = melanger64(cle ^ (uint64_t)taillePaves);
+    for (int i = 0; i < NB_PAVES; i++)
+    {
+        cle = melanger64(cle ^ ((uint64_t)partie->lesPavesX[i] << 32 | (uint64_t)partie->lesPavesY[i]));
+    }
+    return cle;
+}
+
+/************************************************
+		FONCTIONS DE LA RECHERCHE MONTE-CARLO
+*************************************************/
+char directionMcts(tPartie *partie, int numero)
+{
+    // recherche arborescente Monte-Carlo (UCT en boucle ouverte) pour le serpent "numero" :
+    // l'arbre ne porte que ses propres directions, les autres serpents jouent la politique
+    // par défaut pendant toute la simulation. Tous les threads du groupe partent du même état
+    // et construisent chacun leur arbre jusqu'à l'échéance ; la direction la plus visitée,
+    // toutes recherches confondues, est retenue.
+    tMcts *mcts = &partie->mcts;
+    int visites[4] = {0, 0, 0, 0};
+    char meilleureDirection = 0;
+    int meilleuresVisites = 0;
+
+    if (!partie->champAJour)
+    {
+        calculerChampDistances(partie, partie->xPomme, partie->yPomme);
+        partie->champAJour = true;
+    }
+
+    // une seule recherche à la fois (plusieurs serpents peuvent jouer cette stratégie
+    // et être planifiés par des threads différents)
+    pthread_mutex_lock(&mcts->recherche);
+    initialiserEtatMcts(partie, &mcts->racine);
+    mcts->numero = numero;
+    clock_gettime(CLOCK_MONOTONIC, &mcts->echeance);
+    avancerEcheance(&mcts->echeance, partie->budgetMcts);
+
+    pthread_mutex_lock(&mcts->verrou);
+    mcts->nbTermines = 0;
+    mcts->tour++;
+    pthread_cond_broadcast(&mcts->debut);
+    pthread_mutex_unlock(&mcts->verrou);
+
+    rechercherMcts(&mcts->travaux[mcts->nbThreads]);
+
+    pthread_mutex_lock(&mcts->verrou);
+    while (mcts->nbTermines < mcts->nbThreads)
+    {
+        pthread_cond_wait(&mcts->fin, &mcts->verrou);
+    }
+    pthread_mutex_unlock(&mcts->verrou);
+
+    for (int t = 0; t <= mcts->nbThreads; t++)
+    {
+        tTravailMcts *travail = &mcts->travaux[t];
+        for (int a = 0; a < 4; a++)
+        {
+            int enfant = travail->noeuds[0].enfants[a];
+            visites[a] += (enfant >= 0) ? travail->noeuds[enfant].visites : 0;
+        }
+    }
+    pthread_mutex_unlock(&mcts->recherche);
+
+    for (int a = 0; a < 4; a++)
+    {
+        if (visites[a] > meilleuresVisites && !verifierCollisionProchainDeplacement(partie, numero, HAUT + a))
+        {
+            meilleuresVisites = visites[a];
+            meilleureDirection = HAUT + a;
+        }
+    }
+    if (meilleureDirection == 0)
+    {
+        return directionChamp(partie, numero);
+    }
+    // les directions de repli sont classées par visites décroissantes
+    for (int a = 0; a < 4; a++)
+    {
+        partie->serpents[numero].couts[a] = -visites[a];
+    }
+    return meilleureDirection;
+}
+
+void rechercherMcts(tTravailMcts *travail)
+{
+    // itérations de la recherche jusqu'à l'échéance : descente dans l'arbre par UCT,
+    // ajout d'un noeud, simulation par la politique par défaut, puis remontée du gain
+    tPartie *partie = travail->partie;
+    tMcts *mcts = &partie->mcts;
+    tEtatMcts *etat = &travail->etat;
+    int numero = mcts->numero;
+    int chemin[HORIZON_MCTS + 1];
+    struct timespec maintenant;
+
+    travail->nbNoeuds = 1;
+    travail->noeuds[0].visites = 0;
+    travail->noeuds[0].gains = 0;
+    for (int a = 0; a < 4; a++)
+    {
+        travail->noeuds[0].enfants[a] = -1;
+    }
+    travail->iterations = 0;
+
+    while (true)
+    {
+        // l'horloge n'est lue que toutes les 16 itérations
+        if ((travail->iterations & 15) == 0)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &maintenant);
+            if (ecartNs(&mcts->echeance, &maintenant) >= 0)
+            {
+                return;
+            }
+        }
+        travail->iterations++;
+
+        copierEtatMcts(etat, &mcts->racine);
+        int profondeur = 0;
+        int noeud = 0;
+        bool dansArbre = true;
+        int tour;
+        chemin[0] = 0;
+        for (tour = 0; tour < HORIZON_MCTS && etat->serpents[numero].vivant &&
+                       etat->pomme >= 0 && etat->nbVivants >= 2; tour++)
+        {
+            for (int i = 0; i < etat->nbSerpents; i++)
+            {
+                if (etat->serpents[i].vivant && i != numero)
+                {
+                    travail->directions[i] = directionParDefautMcts(partie, etat, i, &travail->graine);
+                }
+            }
+            if (dansArbre)
+            {
+                int action = choisirActionMcts(partie, travail, noeud);
+                if (action < 0)
+                {
+                    dansArbre = false;
+                    travail->directions[numero] = directionParDefautMcts(partie, etat, numero, &travail->graine);
+                }
+                else
+                {
+                    travail->directions[numero] = HAUT + action;
+                    if (travail->noeuds[noeud].enfants[action] < 0)
+                    {
+                        // nouveau noeud : la suite de la partie est simulée hors de l'arbre
+                        int nouveau = travail->nbNoeuds++;
+                        travail->noeuds[nouveau].visites = 0;
+                        travail->noeuds[nouveau].gains = 0;
+                        for (int a = 0; a < 4; a++)
+                        {
+                            travail->noeuds[nouveau].enfants[a] = -1;
+                        }
+                        travail->noeuds[noeud].enfants[action] = nouveau;
+                        dansArbre = false;
+                    }
+                    noeud = travail->noeuds[noeud].enfants[action];
+                    chemin[++profondeur] = noeud;
+                }
+            }
+            else
+            {
+                travail->directions[numero] = directionParDefautMcts(partie, etat, numero, &travail->graine);
+            }
+            deplacerSerpentsMcts(partie, etat, travail->directions);
+        }
+
+        double gain = evaluerEtatMcts(partie, &mcts->racine, etat, numero, tour);
+        for (int p = 0; p <= profondeur; p++)
+        {
+            travail->noeuds[chemin[p]].visites++;
+            travail->noeuds[chemin[p]].gains += gain;
+        }
+    }
+}
+
+int choisirActionMcts(tPartie *partie, tTravailMcts *travail, int noeud)
+{
+    // parmi les directions sans collision immédiate : la première pas encore essayée
+    // (tant qu'il reste de la place pour un noeud), sinon celle de meilleur score UCT1
+    // Q + C * racine(ln(N) / n) ; -1 si aucune direction n'est possible
+    tNoeudMcts *parent = &travail->noeuds[noeud];
+    tEtatMcts *etat = &travail->etat;
+    int numero = partie->mcts.numero;
+    double logParent = (parent->visites > 1) ? log(parent->visites) : 0;
+    int meilleure = -1;
+    double meilleurScore = -1;
+
+    for (int a = 0; a < 4; a++)
+    {
+        if (!directionLibreMcts(partie, etat, numero, HAUT + a))
+        {
+            continue;
+        }
+        int enfant = parent->enfants[a];
+        if (enfant < 0)
+        {
+            if (travail->nbNoeuds < NB_NOEUDS_MCTS)
+            {
+                return a;
+            }
+            continue;
+        }
+        tNoeudMcts *n = &travail->noeuds[enfant];
+        // un enfant créé mais pas encore évalué passe avant les autres
+        double score = (n->visites > 0) ? n->gains / n->visites +
+                                          EXPLORATION_MCTS * sqrt(logParent / n->visites)
+                                        : DBL_MAX;
+        if (score > meilleurScore)
+        {
+            meilleurScore = score;
+            meilleure = a;
+        }
+    }
+    return meilleure;
+}
+
+char directionParDefautMcts(tPartie *partie, const tEtatMcts *etat, int numero, unsigned int *graine)
+{
+    // politique par défaut des simulations : une direction sans collision immédiate,
+    // tirée au hasard une fois sur ALEA_MCTS, sinon celle qui rapproche le plus de la pomme
+    // (champ de distances tant que la pomme est celle du plateau réel, table des distances
+    // entre cases ensuite) ; départage aléatoire des égalités
+    const tSerpentMcts *serpent = &etat->serpents[numero];
+    int tete = serpent->cases[serpent->tete];
+    char possibles[4];
+    int nbPossibles = 0;
+    char meilleure = HAUT;
+    int meilleureDistance = INT_MAX;
+    int xSuivant, ySuivant;
+
+    int debut = rand_r(graine) & 3;
+    for (int k = 0; k < 4; k++)
+    {
+        char direction = HAUT + (debut + k) % 4;
+        if (directionLibreMcts(partie, etat, numero, direction))
+        {
+            possibles[nbPossibles++] = direction;
+        }
+    }
+    if (nbPossibles == 0)
+    {
+        return HAUT;
+    }
+    meilleure = possibles[0];
+    if (etat->pomme < 0 || rand_r(graine) % ALEA_MCTS == 0)
+    {
+        return possibles[rand_r(graine) % nbPossibles];
+    }
+    bool champ = (etat->nbPommes == partie->nbPommes);
+    for (int k = 0; k < nbPossibles; k++)
+    {
+        positionSuivante(CASE_X(tete), CASE_Y(tete), possibles[k], &xSuivant, &ySuivant);
+        int distance = champ ? partie->distancesPomme[CASE(xSuivant, ySuivant)]
+                             : distanceCases(partie, CASE(xSuivant, ySuivant), etat->pomme);
+        if (distance < meilleureDistance)
+        {
+            meilleureDistance = distance;
+            meilleure = possibles[k];
+        }
+    }
+    return meilleure;
+}
+
+bool directionLibreMcts(tPartie *partie, const tEtatMcts *etat, int numero, char direction)
+{
+    // vrai si la case atteinte n'est ni une bordure ni un pavé, ni occupée par un serpent
+    // (sa propre queue exceptée, si elle part à ce tour)
+    const tSerpentMcts *serpent = &etat->serpents[numero];
+    int tete = serpent->cases[serpent->tete];
+    int xSuivant, ySuivant;
+    positionSuivante(CASE_X(tete), CASE_Y(tete), direction, &xSuivant, &ySuivant);
+    int c = CASE(xSuivant, ySuivant);
+    if (partie->plateau[c] == BORDURE)
+    {
+        return false;
+    }
+    if (etat->occupation[c] == 0)
+    {
+        return true;
+    }
+    return etat->occupation[c] == 1 && serpent->aGrandir == 0 &&
+           c == serpent->cases[(serpent->tete + serpent->longueur - 1) % serpent->capacite];
+}
+
+void deplacerSerpentsMcts(tPartie *partie, tEtatMcts *etat, const char *directions)
+{
+    // un tour de jeu sur l'état compact, avec les règles de progresser et de jouerTour :
+    // les serpents avancent dans l'ordre des numéros (la queue part, sauf pendant la croissance),
+    // une bordure ou un pavé arrête le serpent, une case occupée l'élimine (sans croissance,
+    // son propre corps ne compte pas) ; les éliminés quittent le plateau en fin de tour,
+    // puis la pomme mangée est comptée et la suivante posée
+    int mangeur = -1;
+    for (int i = 0; i < etat->nbSerpents; i++)
+    {
+        tSerpentMcts *serpent = &etat->serpents[i];
+        if (!serpent->vivant)
+        {
+            continue;
+        }
+        int tete = serpent->cases[serpent->tete];
+        int xSuivant, ySuivant;
+        positionSuivante(CASE_X(tete), CASE_Y(tete), directions[i], &xSuivant, &ySuivant);
+        int c = CASE(xSuivant, ySuivant);
+        if (partie->plateau[c] == BORDURE)
+        {
+            serpent->vivant = false;
+            etat->nbVivants--;
+            continue;
+        }
+        if (serpent->aGrandir > 0)
+        {
+            serpent->aGrandir--;
+            serpent->longueur++;
+        }
+        else
+        {
+            etat->occupation[serpent->cases[(serpent->tete + serpent->longueur - 1) % serpent->capacite]]--;
+        }
+        serpent->tete = (serpent->tete + serpent->capacite - 1) % serpent->capacite;
+        serpent->cases[serpent->tete] = c;
+        int propres = 0;
+        if (partie->croissance == 0 && etat->occupation[c] > 0)
+        {
+            for (int k = 1; k < serpent->longueur; k++)
+            {
+                propres += (serpent->cases[(serpent->tete + k) % serpent->capacite] == c);
+            }
+        }
+        if (c == etat->pomme && mangeur < 0)
+        {
+            mangeur = i;
+        }
+        else if (etat->occupation[c] > propres)
+        {
+            serpent->vivant = false;
+            etat->nbVivants--;
+        }
+        etat->occupation[c]++;
+    }
+
+    for (int i = 0; i < etat->nbSerpents; i++)
+    {
+        if (!etat->serpents[i].vivant && etat->serpents[i].longueur > 0)
+        {
+            retirerSerpentMcts(etat, i);
+        }
+    }
+    if (mangeur >= 0)
+    {
+        tSerpentMcts *serpent = &etat->serpents[mangeur];
+        serpent->pommes++;
+        if (serpent->vivant)
+        {
+            serpent->aGrandir += partie->croissance;
+        }
+        etat->nbPommes++;
+        etat->pomme = (etat->nbPommes < NB_POMMES) ? casePommeSimulee(partie, etat->occupation, etat->nbPommes) : -1;
+    }
+}
+
+void retirerSerpentMcts(tEtatMcts *etat, int numero)
+{
+    // retire de l'occupation le corps d'un serpent éliminé
+    tSerpentMcts *serpent = &etat->serpents[numero];
+    for (int k = 0; k < serpent->longueur; k++)
+    {
+        etat->occupation[serpent->cases[(serpent->tete + k) % serpent->capacite]]--;
+    }
+    serpent->longueur = 0;
+}
+
+int casePommeSimulee(tPartie *partie, const unsigned char *occupation, int iPomme)
+{
+    // case de la pomme iPomme sur un plateau simulé, décalée sur la case libre suivante
+    // comme dans ajouterPomme
+    int x = partie->lesPommesX[iPomme];
+    int y = partie->lesPommesY[iPomme];
+    while (partie->plateau[CASE(x, y)] == BORDURE || occupation[CASE(x, y)] > 0)
+    {
+        x++;
+        if (x > largeurPlateau)
+        {
+            x = 1;
+            y = (y % hauteurPlateau) + 1;
+        }
+    }
+    return CASE(x, y);
+}
+
+double evaluerEtatMcts(tPartie *partie, const tEtatMcts *racine, const tEtatMcts *etat, int numero, int nbTours)
+{
+    // gain de la simulation entre 0 et 1 : moins de GAIN_MORT_MCTS si le serpent est mort
+    // (d'autant moins qu'il est mort tôt), au-delà s'il a survécu, selon les pommes qu'il
+    // a mangées, celles des autres, les adversaires éliminés et sa distance à la pomme
+    const tSerpentMcts *serpent = &etat->serpents[numero];
+    if (!serpent->vivant)
+    {
+        return GAIN_MORT_MCTS * nbTours / HORIZON_MCTS;
+    }
+    int pommesAutres = 0;
+    for (int i = 0; i < etat->nbSerpents; i++)
+    {
+        pommesAutres += (i != numero) ? etat->serpents[i].pommes : 0;
+    }
+    double score = serpent->pommes - 0.5 * pommesAutres + 0.5 * (racine->nbVivants - etat->nbVivants);
+    if (etat->pomme >= 0)
+    {
+        int tete = serpent->cases[serpent->tete];
+        int distance = distanceCases(partie, tete, etat->pomme);
+        score += (distance == DISTANCE_INFINIE) ? 0 : 0.5 / (1 + distance);
+    }
+    double relatif = score / (1 + ((score < 0) ? -score : score));
+    return GAIN_MORT_MCTS + (1 - GAIN_MORT_MCTS) * (0.5 + 0.5 * relatif);
+}
+
+void creerEtatMcts(tPartie *partie, tEtatMcts *etat)
+{
+    // alloue un état compact pour les serpents de la partie, à la longueur maximale de leur corps
+    etat->nbSerpents = partie->nbSerpents;
+    etat->occupation = allouerMemoire(NB_CASES);
+    etat->serpents = allouerMemoire(partie->nbSerpents * sizeof(tSerpentMcts));
+    for (int i = 0; i < partie->nbSerpents; i++)
+    {
+        etat->serpents[i].capacite = partie->serpents[i].capacite;
+        etat->serpents[i].cases = allouerMemoire(partie->serpents[i].capacite * sizeof(int));
+    }
+}
+
+void libererEtatMcts(tEtatMcts *etat)
+{
+    for (int i = 0; i < etat->nbSerpents; i++)
+    {
+        free(etat->serpents[i].cases);
+    }
+    free(etat->serpents);
+    free(etat->occupation);
+}
+
+void initialiserEtatMcts(tPartie *partie, tEtatMcts *etat)
+{
+    // recopie la partie réelle dans l'état compact (pommes comptées à partir de 0)
+    memcpy(etat->occupation, partie->occupation, NB_CASES);
+    etat->nbPommes = partie->nbPommes;
+    etat->pomme = CASE(partie->xPomme, partie->yPomme);
+    etat->nbVivants = 0;
+    for (int i = 0; i < partie->nbSerpents; i++)
+    {
+        tSerpent *serpent = &partie->serpents[i];
+        tSerpentMcts *copie = &etat->serpents[i];
+        copie->vivant = !serpent->collision;
+        copie->tete = 0;
+        copie->longueur = copie->vivant ? serpent->longueur : 0;
+        copie->aGrandir = serpent->aGrandir;
+        copie->pommes = 0;
+        for (int k = 0; k < copie->longueur; k++)
+        {
+            int anneau = (serpent->tete + k) % serpent->capacite;
+            copie->cases[k] = CASE(serpent->lesX[anneau], serpent->lesY[anneau]);
+        }
+        etat->nbVivants += copie->vivant;
+    }
+}
+
+void copierEtatMcts(tEtatMcts *destination, const tEtatMcts *source)
+{
+    // copie d'un état compact : plateau d'occupation d'un bloc, corps remis à partir de l'indice 0
+    memcpy(destination->occupation, source->occupation, NB_CASES);
+    destination->nbPommes = source->nbPommes;
+    destination->pomme = source->pomme;
+    destination->nbVivants = source->nbVivants;
+    for (int i = 0; i < source->nbSerpents; i++)
+    {
+        const tSerpentMcts *serpent = &source->serpents[i];
+        tSerpentMcts *copie = &destination->serpents[i];
+        copie->vivant = serpent->vivant;
+        copie->tete = 0;
+        copie->longueur = serpent->longueur;
+        copie->aGrandir = serpent->aGrandir;
+        copie->pommes = serpent->pommes;
+        for (int k = 0; k < serpent->longueur; k++)
+        {
+            copie->cases[k] = serpent->cases[(serpent->tete + k) % serpent->capacite];
+        }
+    }
+}
+
+void demarrerMcts(tPartie *partie)
+{
+    // crée les états, les arbres et les threads auxiliaires de la recherche, une fois pour
+    // toutes les parties jouées avec ce contexte (le thread appelant fait aussi sa part)
+    tMcts *mcts = &partie->mcts;
+    mcts->nbThreads = partie->nbThreadsMcts - 1;
+    mcts->threads = allouerMemoire(mcts->nbThreads * sizeof(pthread_t));
+    mcts->travaux = allouerMemoire((mcts->nbThreads + 1) * sizeof(tTravailMcts));
+    mcts->tour = 0;
+    mcts->arret = false;
+    pthread_mutex_init(&mcts->verrou, NULL);
+    pthread_mutex_init(&mcts->recherche, NULL);
+    pthread_cond_init(&mcts->debut, NULL);
+    pthread_cond_init(&mcts->fin, NULL);
+    creerEtatMcts(partie, &mcts->racine);
+    for (int t = 0; t <= mcts->nbThreads; t++)
+    {
+        tTravailMcts *travail = &mcts->travaux[t];
+        travail->partie = partie;
+        travail->graine = GRAINE_TOURNOI + t;
+        travail->iterations = 0;
+        travail->noeuds = allouerMemoire(NB_NOEUDS_MCTS * sizeof(tNoeudMcts));
+        travail->directions = allouerMemoire(partie->nbSerpents);
+        creerEtatMcts(partie, &travail->etat);
+    }
+    for (int t = 0; t < mcts->nbThreads; t++)
+    {
+        if (pthread_create(&mcts->threads[t], NULL, threadMcts, &mcts->travaux[t]) != 0)
+        {
+            perror("pthread_create");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+void arreterMcts(tPartie *partie)
+{
+    // réveille les threads auxiliaires pour qu'ils se terminent, puis libère la mémoire
+    tMcts *mcts = &partie->mcts;
+    if (mcts->travaux == NULL)
+    {
+        return;
+    }
+    pthread_mutex_lock(&mcts->verrou);
+    mcts->arret = true;
+    pthread_cond_broadcast(&mcts->debut);
+    pthread_mutex_unlock(&mcts->verrou);
+    for (int t = 0; t < mcts->nbThreads; t++)
+    {
+        pthread_join(mcts->threads[t], NULL);
+    }
+    for (int t = 0; t <= mcts->nbThreads; t++)
+    {
+        free(mcts->travaux[t].noeuds);
+        free(mcts->travaux[t].directions);
+        libererEtatMcts(&mcts->travaux[t].etat);
+    }
+    libererEtatMcts(&mcts->racine);
+    pthread_mutex_destroy(&mcts->verrou);
+    pthread_mutex_destroy(&mcts->recherche);
+    pthread_cond_destroy(&mcts->debut);
+    pthread_cond_destroy(&mcts->fin);
+    free(mcts->threads);
+    free(mcts->travaux);
+    mcts->threads = NULL;
+    mcts->travaux = NULL;
+}
+
+void *threadMcts(void *arg)
+{
+    // à chaque nouvelle recherche, construit son propre arbre jusqu'à l'échéance
+    tTravailMcts *travail = arg;
+    tMcts *mcts = &travail->partie->mcts;
+    int tourTraite = 0;
+
+    while (true)
+    {
+        pthread_mutex_lock(&mcts->verrou);
+        while (!mcts->arret && mcts->tour == tourTraite)
+        {
+            pthread_cond_wait(&mcts->debut, &mcts->verrou);
+        }
+        if (mcts->arret)
+        {
+            pthread_mutex_unlock(&mcts->verrou);
+            return NULL;
+        }
+        tourTraite = mcts->tour;
+        pthread_mutex_unlock(&mcts->verrou);
+
+        rechercherMcts(travail);
+
+        pthread_mutex_lock(&mcts->verrou);
+        if (++mcts->nbTermines == mcts->nbThreads)
+        {
+            pthread_cond_signal(&mcts->fin);
+        }
+        pthread_mutex_unlock(&mcts->verrou);
+    }
+}
+
+/************************************************
+		FONCTIONS DE LA RECHERCHE ALPHA-BETA
+*************************************************/
+char directionAlphaBeta(tPartie *partie, int numero)
+{
+    // duel contre l'adversaire dont la tête est la plus proche (issues comprises),
+    // s'il est à moins de RAYON_DUEL_AB
+    // cases : recherche minimax à coups simultanés, approfondie d'un tour à la fois jusqu'à
+    // l'échéance ; les autres serpents restent en place. Loin de tout adversaire, le serpent
+    // suit le champ de distances.
+    tSerpent *serpent = &partie->serpents[numero];
+    tAlphaBeta *ab = &partie->alphaBeta;
+    int xTete = serpent->lesX[serpent->tete];
+    int yTete = serpent->lesY[serpent->tete];
+    int adversaire = -1;
+    int distanceAdversaire = RAYON_DUEL_AB + 1;
+    int meilleurCoup = -1;
+
+    if (!partie->champAJour)
+    {
+        calculerChampDistances(partie, partie->xPomme, partie->yPomme);
+        partie->champAJour = true;
+    }
+    for (int i = 0; i < partie->nbSerpents; i++)
+    {
+        tSerpent *autre = &partie->serpents[i];
+        if (i == numero || autre->collision)
+        {
+            continue;
+        }
+        int distance = distanceCases(partie, CASE(autre->lesX[autre->tete], autre->lesY[autre->tete]),
+                                     CASE(xTete, yTete));
+        if (distance < distanceAdversaire)
+        {
+            distanceAdversaire = distance;
+            adversaire = i;
+        }
+    }
+    if (adversaire < 0)
+    {
+        return directionChamp(partie, numero);
+    }
+
+    // une seule recherche à la fois : la table de transposition et l'état du duel sont partagés
+    pthread_mutex_lock(&ab->recherche);
+    initialiserDuel(partie, numero, adversaire);
+    clock_gettime(CLOCK_MONOTONIC, &ab->echeance);
+    avancerEcheance(&ab->echeance, partie->budgetAlphaBeta);
+    ab->noeuds = 0;
+    ab->interrompue = false;
+    for (int profondeur = 1; profondeur <= PROFONDEUR_MAX_AB; profondeur++)
+    {
+        int coup;
+        int valeur = rechercherDuel(partie, profondeur, 0, &coup);
+        if (ab->interrompue)
+        {
+            break;
+        }
+        meilleurCoup = coup;
+        // issue du duel certaine : inutile de chercher plus loin
+        if (valeur >= VALEUR_MORT_AB - PROFONDEUR_MAX_AB || valeur <= -VALEUR_MORT_AB + PROFONDEUR_MAX_AB)
+        {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&ab->recherche);
+
+    if (meilleurCoup < 0 || verifierCollisionProchainDeplacement(partie, numero, HAUT + meilleurCoup))
+    {
+        return directionChamp(partie, numero);
+    }
+    return HAUT + meilleurCoup;
+}
+
+int rechercherDuel(tPartie *partie, int profondeur, int ply, int *meilleurCoup)
+{
+    // valeur du duel pour le serpent qui cherche (indice 0), à profondeur tours près : les deux
+    // serpents jouent en même temps, chacune des 16 paires de directions est jouée et évaluée,
+    // et la valeur du tour est celle du jeu à coups simultanés formé par ces 16 valeurs (voir
+    // valeurJeuSimultane) ; les positions déjà évaluées, à ce tour ou aux précédents, sont
+    // reprises de la table de transposition
+    tAlphaBeta *ab = &partie->alphaBeta;
+    int valeurs[4][4];
+    *meilleurCoup = -1;
+
+    if ((++ab->noeuds & 255) == 0)
+    {
+        struct timespec maintenant;
+        clock_gettime(CLOCK_MONOTONIC, &maintenant);
+        if (ecartNs(&ab->echeance, &maintenant) >= 0)
+        {
+            ab->interrompue = true;
+        }
+    }
+    if (ab->interrompue)
+    {
+        return 0;
+    }
+    if (!ab->serpents[0].vivant || !ab->serpents[1].vivant || ab->pomme < 0 || profondeur == 0)
+    {
+        return evaluerDuel(partie, ply);
+    }
+
+    // jamais à la racine, où le coup doit être celui de la recherche en cours
+    uint64_t cle = cleDuel(ab);
+    tEntreeAB *entree = &ab->table[cle & (TAILLE_TABLE_AB - 1)];
+    if (ply > 0 && entree->cle == cle && entree->profondeur >= profondeur)
+    {
+        *meilleurCoup = entree->coup;
+        return valeurDepuisTableAB(entree->valeur, ply);
+    }
+
+    for (int coup = 0; coup < 4; coup++)
+    {
+        for (int reponse = 0; reponse < 4; reponse++)
+        {
+            tAnnulationAB annulation;
+            int sansCoup;
+            char coups[2] = {HAUT + coup, HAUT + reponse};
+            deplacerDuel(partie, coups, &annulation);
+            valeurs[coup][reponse] = rechercherDuel(partie, profondeur - 1, ply + 1, &sansCoup);
+            annulerDuel(ab, &annulation);
+            if (ab->interrompue)
+            {
+                return 0;
+            }
+        }
+    }
+    int valeur = valeurJeuSimultane(valeurs, meilleurCoup);
+
+    // remplacement si l'entrée vient d'une autre recherche ou d'une recherche moins profonde
+    if (entree->cle != cle || entree->recherche != ab->numeroRecherche || entree->profondeur <= profondeur)
+    {
+        entree->cle = cle;
+        entree->recherche = ab->numeroRecherche;
+        entree->valeur = (short)valeurVersTableAB(valeur, ply);
+        entree->profondeur = (signed char)profondeur;
+        entree->coup = (unsigned char)*meilleurCoup;
+    }
+    return valeur;
+}
+
+int valeurJeuSimultane(int valeurs[4][4], int *meilleurCoup)
+{
+    // valeur, pour le serpent 0, du tour dont valeurs donne l'issue de chaque paire de
+    // directions (ligne : la sienne, colonne : celle de l'adversaire), aucun des deux ne
+    // connaissant le coup de l'autre. S'il existe un point selle, c'est sa valeur et
+    // meilleurCoup est sa ligne ; sinon la valeur en stratégies mixtes est approchée par
+    // jeu fictif (chacun répond au mélange des coups joués jusque-là par l'autre), entre la
+    // garantie du mélange du serpent 0 et celle du mélange de l'adversaire, et meilleurCoup
+    // est la direction que le serpent 0 a jouée le plus souvent
+    int maxMin = -VALEUR_INFINIE_AB, minMax = VALEUR_INFINIE_AB;
+    int ligne = 0, colonne = 0;
+    for (int i = 0; i < 4; i++)
     {
-        return HAUT;
+        int pire = VALEUR_INFINIE_AB, meilleure = -VALEUR_INFINIE_AB;
+        for (int j = 0; j < 4; j++)
+        {
+            pire = (valeurs[i][j] < pire) ? valeurs[i][j] : pire;
+            meilleure = (valeurs[j][i] > meilleure) ? valeurs[j][i] : meilleure;
+        }
+        if (pire > maxMin)
+        {
+            maxMin = pire;
+            ligne = i;
+        }
+        if (meilleure < minMax)
+        {
+            minMax = meilleure;
+            colonne = i;
+        }
     }
-    else if (passageTrouBas <= passageTrouGauche && passageTrouBas <= passageTrouDroit)
+    *meilleurCoup = ligne;
+    if (maxMin == minMax)
     {
-        return BAS;
+        return maxMin;
     }
-    else if (passageTrouGauche <= passageTrouDroit)
+
+    // sommeLignes[i] : gain de la ligne i contre les colonnes jouées jusque-là,
+    // sommeColonnes[j] : gain concédé par la colonne j contre les lignes jouées
+    long sommeLignes[4] = {0, 0, 0, 0}, sommeColonnes[4] = {0, 0, 0, 0};
+    int joues[4] = {0, 0, 0, 0};
+    for (int t = 0; t < ITERATIONS_JEU_AB; t++)
     {
-        return GAUCHE;
+        joues[ligne]++;
+        for (int k = 0; k < 4; k++)
+        {
+            sommeLignes[k] += valeurs[k][colonne];
+            sommeColonnes[k] += valeurs[ligne][k];
+        }
+        for (int k = 0; k < 4; k++)
+        {
+            ligne = (sommeLignes[k] > sommeLignes[ligne]) ? k : ligne;
+            colonne = (sommeColonnes[k] < sommeColonnes[colonne]) ? k : colonne;
+        }
     }
-    else
+    long garantie = sommeColonnes[0], concession = sommeLignes[0];
+    for (int k = 1; k < 4; k++)
     {
-        return DROITE;
+        garantie = (sommeColonnes[k] < garantie) ? sommeColonnes[k] : garantie;
+        concession = (sommeLignes[k] > concession) ? sommeLignes[k] : concession;
     }
+    for (int k = 0; k < 4; k++)
+    {
+        *meilleurCoup = (joues[k] > joues[*meilleurCoup]) ? k : *meilleurCoup;
+    }
+    int valeur = (int)((garantie + concession) / (2 * ITERATIONS_JEU_AB));
+    return (valeur < maxMin) ? maxMin : (valeur > minMax) ? minMax : valeur;
 }
 
-bool verifierCollisionProchainDeplacement1(int lesX1[], int lesY1[], tPlateau plateau, char prochaineDirection1, int lesX2[], int lesY2[], char directionSerpent2)
+int valeurVersTableAB(int valeur, int ply)
 {
-    int nouvelleX = lesX1[0];
-    int nouvelleY = lesY1[0];
+    // les valeurs de mort (VALEUR_MORT_AB moins le nombre de tours depuis la racine) sont
+    // rangées dans la table relativement à la position, pour rester justes quand elle est
+    // retrouvée à une autre distance de la racine (valeurDepuisTableAB fait l'inverse)
+    if (valeur >= VALEUR_MORT_AB - PROFONDEUR_MAX_AB)
+    {
+        return valeur + ply;
+    }
+    if (valeur <= -VALEUR_MORT_AB + PROFONDEUR_MAX_AB)
+    {
+        return valeur - ply;
+    }
+    return valeur;
+}
 
-    // Calcul de la nouvelle position
-    switch (prochaineDirection1)
+int valeurDepuisTableAB(int valeur, int ply)
+{
+    if (valeur >= VALEUR_MORT_AB - PROFONDEUR_MAX_AB)
     {
-        case HAUT:
-            nouvelleY--;
-            break;
-        case BAS:
-            nouvelleY++;
-            break;
-        case GAUCHE:
-            nouvelleX--;
-            break;
-        case DROITE:
-            nouvelleX++;
-            break;
+        return valeur - ply;
     }
+    if (valeur <= -VALEUR_MORT_AB + PROFONDEUR_MAX_AB)
+    {
+        return valeur + ply;
+    }
+    return valeur;
+}
 
-    // Collision avec les bordures
-    if (plateau[nouvelleX][nouvelleY] == BORDURE)
+int evaluerDuel(tPartie *partie, int ply)
+{
+    // valeur d'une position pour le serpent qui cherche : une mort est d'autant moins grave
+    // qu'elle arrive tard, une élimination de l'adversaire d'autant meilleure qu'elle arrive tôt ;
+    // sinon, écart des pommes mangées depuis le début de la partie (la valeur ne dépend ainsi
+    // que de la position, pas du tour où la recherche a commencé) puis écart des distances à la pomme
+    tAlphaBeta *ab = &partie->alphaBeta;
+    tSerpentMcts *moi = &ab->serpents[0];
+    tSerpentMcts *adversaire = &ab->serpents[1];
+    if (!moi->vivant)
     {
-        return true;
+        return adversaire->vivant ? -VALEUR_MORT_AB + ply : -VALEUR_MORT_AB / 2;
+    }
+    if (!adversaire->vivant)
+    {
+        return VALEUR_MORT_AB - ply;
+    }
+    int valeur = POIDS_POMME_AB * (moi->pommes - adversaire->pommes);
+    if (ab->pomme >= 0)
+    {
+        valeur += distanceDuel(partie, adversaire) - distanceDuel(partie, moi);
     }
+    return valeur;
+}
+
+int distanceDuel(tPartie *partie, const tSerpentMcts *serpent)
+{
+    // distance de la tête à la pomme : par le champ de distances tant que la pomme est celle
+    // du plateau réel, par la table des distances entre cases ensuite ; bornée pour rester
+    // loin des valeurs de pomme
+    tAlphaBeta *ab = &partie->alphaBeta;
+    int tete = serpent->cases[serpent->tete];
+    int distance = (ab->nbPommes == partie->nbPommes)
+                   ? partie->distancesPomme[tete]
+                   : distanceCases(partie, tete, ab->pomme);
+    return (distance < POIDS_POMME_AB / 2) ? distance : POIDS_POMME_AB / 2;
+}
 
-    // Collision tête contre tête avec le serpent 2
-    if (nouvelleX == lesX2[0] && nouvelleY == lesY2[0])
+void deplacerDuel(tPartie *partie, const char *coups, tAnnulationAB *annulation)
+{
+    // un tour du duel, avec les règles de progresser et de jouerTour (les deux serpents avancent
+    // dans l'ordre de leur numéro), en tenant la clé de hachage à jour et en notant dans
+    // annulation de quoi revenir en arrière
+    tAlphaBeta *ab = &partie->alphaBeta;
+    int mangeur = -1;
+    annulation->serpents[0] = ab->serpents[0];
+    annulation->serpents[1] = ab->serpents[1];
+    annulation->pomme = ab->pomme;
+    annulation->nbPommes = ab->nbPommes;
+    annulation->cle = ab->cle;
+    for (int j = 0; j < 2; j++)
     {
-        // Si les serpents sont à égale distance de la pomme, 
-        // le serpent 2 a la priorité (le serpent 1 doit éviter)
-        if (plateau[lesX2[0]][lesY2[0]] == POMME)
+        int k = (ab->numeros[0] < ab->numeros[1]) ? j : 1 - j;
+        tSerpentMcts *serpent = &ab->serpents[k];
+        int ancienneTete = serpent->cases[serpent->tete];
+        int xSuivant, ySuivant;
+        annulation->avance[k] = false;
+        positionSuivante(CASE_X(ancienneTete), CASE_Y(ancienneTete), coups[k], &xSuivant, &ySuivant);
+        int c = CASE(xSuivant, ySuivant);
+        if (partie->plateau[c] == BORDURE)
         {
-            return true;
+            serpent->vivant = false;
+            continue;
         }
-        return true;
-    }
+        annulation->avance[k] = true;
+        annulation->queue[k] = -1;
+        if (serpent->aGrandir > 0)
+        {
+            serpent->aGrandir--;
+            serpent->longueur++;
+        }
+        else
+        {
+            int queue = serpent->cases[(serpent->tete + serpent->longueur - 1) % serpent->capacite];
+            ab->occupation[queue]--;
+            ab->cle ^= cleZobrist(queue, k, ZOBRIST_CORPS);
+            annulation->queue[k] = queue;
+        }
+        serpent->tete = (serpent->tete + serpent->capacite - 1) % serpent->capacite;
+        annulation->ecrase[k] = serpent->cases[serpent->tete];
+        serpent->cases[serpent->tete] = c;
+        annulation->tete[k] = c;
+        ab->cle ^= cleZobrist(ancienneTete, k, ZOBRIST_TETE) ^ cleZobrist(c, k, ZOBRIST_TETE);
 
-    // Prédiction de la prochaine position du serpent 2
-    int prochaineX2 = lesX2[0];
-    int prochaineY2 = lesY2[0];
-    switch (directionSerpent2) {
-        case HAUT:
-            prochaineY2--;
-            break;
-        case BAS:
-            prochaineY2++;
-            break;
-        case GAUCHE:
-            prochaineX2--;
-            break;
-        case DROITE:
-            prochaineX2++;
-            break;
+        int propres = 0;
+        if (partie->croissance == 0 && ab->occupation[c] > 0)
+        {
+            for (int a = 1; a < serpent->longueur; a++)
+            {
+                propres += (serpent->cases[(serpent->tete + a) % serpent->capacite] == c);
+            }
+        }
+        if (c == ab->pomme && mangeur < 0)
+        {
+            mangeur = k;
+        }
+        else if (ab->occupation[c] > propres)
+        {
+            serpent->vivant = false;
+        }
+        ab->occupation[c]++;
+        ab->cle ^= cleZobrist(c, k, ZOBRIST_CORPS);
     }
-
-    // Si la nouvelle position va créer une collision, éviter
-    if (nouvelleX == prochaineX2 && nouvelleY == prochaineY2)
+    if (mangeur >= 0)
     {
-        return true;
+        tSerpentMcts *serpent = &ab->serpents[mangeur];
+        serpent->pommes++;
+        if (serpent->vivant)
+        {
+            serpent->aGrandir += partie->croissance;
+        }
+        ab->cle ^= clePommeZobrist(ab->nbPommes);
+        ab->nbPommes++;
+        ab->cle ^= clePommeZobrist(ab->nbPommes);
+        ab->pomme = (ab->nbPommes < NB_POMMES) ? casePommeSimulee(partie, ab->occupation, ab->nbPommes) : -1;
     }
+}
 
-    // Collision avec le corps des deux serpents
-    for (int i = 0; i < TAILLE; i++)
+void annulerDuel(tAlphaBeta *ab, const tAnnulationAB *annulation)
+{
+    // revient sur le tour joué par deplacerDuel
+    for (int k = 0; k < 2; k++)
     {
-        if ((lesX1[i] == nouvelleX && lesY1[i] == nouvelleY) || 
-            (lesX2[i] == nouvelleX && lesY2[i] == nouvelleY))
+        if (!annulation->avance[k])
+        {
+            continue;
+        }
+        tSerpentMcts *serpent = &ab->serpents[k];
+        ab->occupation[annulation->tete[k]]--;
+        if (annulation->queue[k] >= 0)
         {
-            return true;
+            ab->occupation[annulation->queue[k]]++;
         }
+        serpent->cases[serpent->tete] = annulation->ecrase[k];
     }
-
-    return false;
+    ab->serpents[0] = annulation->serpents[0];
+    ab->serpents[1] = annulation->serpents[1];
+    ab->pomme = annulation->pomme;
+    ab->nbPommes = annulation->nbPommes;
+    ab->cle = annulation->cle;
 }
 
-void progresser1(int lesX1[], int lesY1[], char direction1, tPlateau plateau, bool *collision1, bool *pommeMangee1, bool *utiliserIssue1)
+void initialiserDuel(tPartie *partie, int numero, int adversaire)
 {
-    // Effacer l'ancienne position du serpent dans le plateau
-    plateau[lesX1[TAILLE - 1]][lesY1[TAILLE - 1]] = VIDE;
-    for (int i = 0; i < TAILLE; i++) {
-        plateau[lesX1[i]][lesY1[i]] = VIDE;
-    }
-    
-    // Effacer le dernier élément à l'écran
-    effacer(lesX1[TAILLE - 1], lesY1[TAILLE - 1]);
+    // recopie le plateau et les deux serpents du duel (corps remis à partir de l'indice 0)
+    // et calcule la clé de hachage de la position, corps des autres serpents et ordre de jeu
+    // des deux serpents compris ; la mémoire est allouée à la première recherche, les corps
+    // étant prévus assez longs pour grandir pendant toute la recherche
+    tAlphaBeta *ab = &partie->alphaBeta;
+    int numeros[2] = {numero, adversaire};
+    int capacite = partie->serpents[numero].capacite + PROFONDEUR_MAX_AB;
 
-    // Mettre à jour les positions
-    for (int i = TAILLE - 1; i > 0; i--)
+    if (ab->table == NULL)
     {
-        lesX1[i] = lesX1[i - 1];
-        lesY1[i] = lesY1[i - 1];
+        ab->table = allouerMemoire(TAILLE_TABLE_AB * sizeof(tEntreeAB));
+        memset(ab->table, 0, TAILLE_TABLE_AB * sizeof(tEntreeAB));
+        ab->occupation = allouerMemoire(NB_CASES);
     }
-    
-    // Faire progresser la tête dans la nouvelle direction
-    switch (direction1)
+    if (ab->capacite != capacite)
     {
-        case HAUT:
-            lesY1[0] = lesY1[0] - 1;
-            break;
-        case BAS:
-            lesY1[0] = lesY1[0] + 1;
-            break;
-        case DROITE:
-            lesX1[0] = lesX1[0] + 1;
-            break;
-        case GAUCHE:
-            lesX1[0] = lesX1[0] - 1;
-            break;
+        for (int k = 0; k < 2; k++)
+        {
+            free(ab->serpents[k].cases);
+            ab->serpents[k].cases = allouerMemoire(capacite * sizeof(int));
+        }
+        ab->capacite = capacite;
     }
-
-    // Gestion des passages par les issues
-    if (lesX1[0] <= 0)
+    ab->numeroRecherche++;
+    memcpy(ab->occupation, partie->occupation, NB_CASES);
+    ab->nbPommes = partie->nbPommes;
+    ab->pomme = CASE(partie->xPomme, partie->yPomme);
+    ab->cle = cleCarte(partie) ^ clePommeZobrist(ab->nbPommes);
+    if (numero > adversaire)
     {
-        lesX1[0] = LARGEUR_PLATEAU;
-        *utiliserIssue1 = true;
+        ab->cle = melanger64(ab->cle);
     }
-    else if (lesX1[0] > LARGEUR_PLATEAU)
+    for (int i = 0; i < partie->nbSerpents; i++)
     {
-        lesX1[0] = 1;
-        *utiliserIssue1 = true;
+        tSerpent *autre = &partie->serpents[i];
+        if (i == numero || i == adversaire || autre->retire)
+        {
+            continue;
+        }
+        for (int a = 0; a < autre->longueur; a++)
+        {
+            int anneau = (autre->tete + a) % autre->capacite;
+            ab->cle ^= cleZobrist(CASE(autre->lesX[anneau], autre->lesY[anneau]), SERPENTS_AUTRES_AB, ZOBRIST_CORPS);
+        }
     }
-    else if (lesY1[0] <= 0)
+    for (int k = 0; k < 2; k++)
     {
-        lesY1[0] = HAUTEUR_PLATEAU;
-        *utiliserIssue1 = true;
+        tSerpent *serpent = &partie->serpents[numeros[k]];
+        tSerpentMcts *copie = &ab->serpents[k];
+        ab->numeros[k] = numeros[k];
+        copie->capacite = capacite;
+        copie->tete = 0;
+        copie->longueur = serpent->longueur;
+        copie->aGrandir = serpent->aGrandir;
+        copie->pommes = serpent->nbPommes;
+        copie->vivant = true;
+        for (int a = 0; a < serpent->longueur; a++)
+        {
+            int anneau = (serpent->tete + a) % serpent->capacite;
+            copie->cases[a] = CASE(serpent->lesX[anneau], serpent->lesY[anneau]);
+            ab->cle ^= cleZobrist(copie->cases[a], k, ZOBRIST_CORPS);
+        }
+        ab->cle ^= cleZobrist(copie->cases[0], k, ZOBRIST_TETE);
     }
-    else if (lesY1[0] > HAUTEUR_PLATEAU)
+}
+
+uint64_t cleDuel(const tAlphaBeta *ab)
+{
+    // clé de la position : corps, têtes, numéro de la pomme et plateau (tenus à jour par
+    // deplacerDuel), plus les anneaux qu'il reste à chaque serpent pour grandir et ses pommes
+    // mangées, dont dépend la valeur de la position
+    return ab->cle ^ melanger64(((uint64_t)ab->serpents[0].aGrandir << 32 | (uint64_t)ab->serpents[1].aGrandir) + 0x5bd1e995)
+                   ^ melanger64(~((uint64_t)ab->serpents[0].pommes << 32 | (uint64_t)ab->serpents[1].pommes));
+}
+
+uint64_t cleZobrist(int c, int serpent, int nature)
+{
+    // valeur aléatoire fixe associée à un morceau (ZOBRIST_CORPS ou ZOBRIST_TETE) du serpent 0
+    // ou 1, ou d'un des autres serpents (SERPENTS_AUTRES_AB), sur la case c : obtenue par
+    // mélange plutôt que rangée dans une table, pour ne pas allouer six mots par case sur
+    // les grands plateaux
+    return melanger64(((uint64_t)c << 3) | ((uint64_t)serpent << 1) | (uint64_t)nature);
+}
+
+uint64_t clePommeZobrist(int iPomme)
+{
+    return melanger64(~(uint64_t)iPomme);
+}
+
+uint64_t melanger64(uint64_t x)
+{
+    // fonction de mélange de splitmix64 : chaque bit de x change la moitié des bits du résultat
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/************************************************
+		FONCTIONS BIT A BIT SUR LE PLATEAU
+*************************************************/
+void creerBitboard(tBitboard *bitboard)
+{
+    bitboard->mots = allouerMemoire(NB_MOTS_BITBOARD * sizeof(uint64_t));
+}
+
+void libererBitboard(tBitboard *bitboard)
+{
+    free(bitboard->mots);
+    bitboard->mots = NULL;
+}
+
+void copierBitboard(tBitboard *destination, const tBitboard *source)
+{
+    memcpy(destination->mots, source->mots, NB_MOTS_BITBOARD * sizeof(uint64_t));
+}
+
+void viderBitboard(tBitboard *bitboard)
+{
+    memset(bitboard->mots, 0, NB_MOTS_BITBOARD * sizeof(uint64_t));
+}
+
+void activerBit(tBitboard *bitboard, int x, int y)
+{
+    size_t i = (size_t)(y - 1) * largeurPlateau + (x - 1);
+    bitboard->mots[i / 64] |= (uint64_t)1 << (i % 64);
+}
+
+void desactiverBit(tBitboard *bitboard, int x, int y)
+{
+    size_t i = (size_t)(y - 1) * largeurPlateau + (x - 1);
+    bitboard->mots[i / 64] &= ~((uint64_t)1 << (i % 64));
+}
+
+bool testerBit(const tBitboard *bitboard, int x, int y)
+{
+    size_t i = (size_t)(y - 1) * largeurPlateau + (x - 1);
+    return (bitboard->mots[i / 64] >> (i % 64)) & 1;
+}
+
+int compterBits(const tBitboard *bitboard)
+{
+    int total = 0;
+    for (size_t i = 0; i < NB_MOTS_BITBOARD; i++)
     {
-        lesY1[0] = 1;
-        *utiliserIssue1 = true;
+        total += __builtin_popcountll(bitboard->mots[i]);
     }
+    return total;
+}
 
-    *pommeMangee1 = false;
-    // Vérification des collisions et mise à jour du plateau
-    if (plateau[lesX1[0]][lesY1[0]] == POMME)
+uint64_t motLibre(tPartie *partie, size_t i)
+{
+    // mot i des cases qui ne sont ni une bordure, ni un pavé, ni un morceau de serpent
+    uint64_t mot = ~(partie->murs.mots[i] | partie->paves.mots[i] | partie->corps.mots[i]);
+    // les bits au-delà de la dernière case ne correspondent à aucune case
+    if (i == NB_MOTS_BITBOARD - 1 && ((size_t)largeurPlateau * hauteurPlateau) % 64 != 0)
     {
-        *pommeMangee1 = true;
-        plateau[lesX1[0]][lesY1[0]] = VIDE;
+        mot &= ((uint64_t)1 << (((size_t)largeurPlateau * hauteurPlateau) % 64)) - 1;
     }
-    else if (plateau[lesX1[0]][lesY1[0]] == BORDURE)
+    return mot;
+}
+
+void casesLibres(tPartie *partie, tBitboard *libres)
+{
+    for (size_t i = 0; i < NB_MOTS_BITBOARD; i++)
     {
-        *collision1 = true;
+        libres->mots[i] = motLibre(partie, i);
     }
-    else if (plateau[lesX1[0]][lesY1[0]] == TETE_SERPENT_2 || plateau[lesX1[0]][lesY1[0]] == CORPS)
+}
+
+int compterCasesLibres(tPartie *partie)
+{
+    tBitboard libres;
+    int total;
+    creerBitboard(&libres);
+    casesLibres(partie, &libres);
+    total = compterBits(&libres);
+    libererBitboard(&libres);
+    return total;
+}
+
+uint64_t motBorne(const tBitboard *bitboard, long i, long debut, long fin)
+{
+    // mot i du plateau bit à bit, seuls les mots debut à fin pouvant être non nuls
+    return (i >= debut && i <= fin) ? bitboard->mots[i] : 0;
+}
+
+void preparerRemplissage(tAEtoile *aEtoile)
+{
+    // plateaux bit à bit de remplirDepuis, alloués (à zéro) au premier remplissage du thread
+    if (aEtoile->atteintes.mots == NULL)
     {
-        *collision1 = true;
+        creerBitboard(&aEtoile->atteintes);
+        creerBitboard(&aEtoile->nouvelles);
+        aEtoile->debutRempli = 0;
+        aEtoile->finRempli = -1;
     }
+}
 
-    // Mise à jour du plateau avec les nouvelles positions
-    plateau[lesX1[0]][lesY1[0]] = TETE_SERPENT_1;
-    for (int i = 1; i < TAILLE; i++) {
-        plateau[lesX1[i]][lesY1[i]] = CORPS;
+int remplirDepuis(tPartie *partie, int x, int y, int borne, tAEtoile *aEtoile)
+{
+    // remplissage par diffusion de la zone libre accessible depuis (x, y), 64 cases à la fois :
+    // à chaque étape la zone atteinte s'étend d'une case dans les quatre directions, puis
+    // d'une issue à l'autre, jusqu'à ce qu'elle ne grandisse plus ou atteigne borne cases ;
+    // retourne le nombre de cases atteintes (la zone est laissée dans aEtoile->atteintes).
+    // Seuls les mots debut à fin, qui encadrent la zone à une ligne près, sont parcourus,
+    // et seuls ceux du remplissage précédent sont effacés (voir preparerRemplissage)
+    int issuesX[4] = {xIssues, xIssues, 1, largeurPlateau};
+    int issuesY[4] = {1, hauteurPlateau, yIssues, yIssues};
+    const int ISSUE_OPPOSEE[4] = {1, 0, 3, 2};
+    long nbMots = (long)NB_MOTS_BITBOARD;
+    long motsParLigne = largeurPlateau / 64 + 1;
+    long motsLigne = largeurPlateau / 64;
+    int bitsLigne = largeurPlateau % 64;
+    bool change = true;
+    int total = 1;
+
+    for (long i = aEtoile->debutRempli; i <= aEtoile->finRempli; i++)
+    {
+        aEtoile->atteintes.mots[i] = 0;
+        aEtoile->nouvelles.mots[i] = 0;
+    }
+    long debut = ((long)(y - 1) * largeurPlateau + (x - 1)) / 64;
+    long fin = debut;
+    aEtoile->debutRempli = debut;
+    aEtoile->finRempli = fin;
+    if (!(motLibre(partie, (size_t)debut) & ((uint64_t)1 << (((long)(y - 1) * largeurPlateau + (x - 1)) % 64))))
+    {
+        return 0;
     }
+    activerBit(&aEtoile->atteintes, x, y);
+
+    while (change && total < borne)
+    {
+        const tBitboard *atteintes = &aEtoile->atteintes;
+        tBitboard *nouvelles = &aEtoile->nouvelles;
+        // la zone grandit d'au plus une ligne de chaque côté, ou d'une issue à l'autre
+        long debutAvant = aEtoile->debutRempli, finAvant = aEtoile->finRempli;
+        debut = debutAvant;
+        fin = finAvant;
+        debut = (debut - motsParLigne - 1 > 0) ? debut - motsParLigne - 1 : 0;
+        fin = (fin + motsParLigne + 1 < nbMots - 1) ? fin + motsParLigne + 1 : nbMots - 1;
+        bool issueAtteinte[4];
+        for (int k = 0; k < 4; k++)
+        {
+            issueAtteinte[k] = testerBit(atteintes, issuesX[k], issuesY[k]);
+            if (issueAtteinte[k])
+            {
+                int o = ISSUE_OPPOSEE[k];
+                long mot = ((long)(issuesY[o] - 1) * largeurPlateau + (issuesX[o] - 1)) / 64;
+                debut = (mot < debut) ? mot : debut;
+                fin = (mot > fin) ? mot : fin;
+            }
+        }
+        // décalages d'une case (un bit) et d'une ligne (motsLigne mots et bitsLigne bits) ;
+        // les colonnes 1 et largeurPlateau ne sont pas voisines l'une de l'autre
+        for (long i = debut; i <= fin; i++)
+        {
+            uint64_t centre = motBorne(atteintes, i, debutAvant, finAvant);
+            uint64_t avant = motBorne(atteintes, i - 1, debutAvant, finAvant);
+            uint64_t apres = motBorne(atteintes, i + 1, debutAvant, finAvant);
+            uint64_t dessus = motBorne(atteintes, i - motsLigne, debutAvant, finAvant);
+            uint64_t dessous = motBorne(atteintes, i + motsLigne, debutAvant, finAvant);
+            uint64_t mot = centre;
+            mot |= ((centre << 1) | (avant >> 63)) & ~partie->colonneGauche.mots[i];
+            mot |= ((centre >> 1) | (apres << 63)) & ~partie->colonneDroite.mots[i];
+            if (bitsLigne == 0)
+            {
+                mot |= dessus | dessous;
+            }
+            else
+            {
+                mot |= (dessus << bitsLigne) | (motBorne(atteintes, i - motsLigne - 1, debutAvant, finAvant) >> (64 - bitsLigne));
+                mot |= (dessous >> bitsLigne) | (motBorne(atteintes, i + motsLigne + 1, debutAvant, finAvant) << (64 - bitsLigne));
+            }
+            nouvelles->mots[i] = mot;
+        }
+        for (int k = 0; k < 4; k++)
+        {
+            if (issueAtteinte[k])
+            {
+                activerBit(nouvelles, issuesX[ISSUE_OPPOSEE[k]], issuesY[ISSUE_OPPOSEE[k]]);
+            }
+        }
 
-    // Dessiner le serpent à l'écran
-    dessinerSerpent1(lesX1, lesY1);
+        // la zone grandie, son nombre de cases et ses premier et dernier mots non nuls en un
+        // seul passage, puis échange des deux plateaux (la nouvelle zone devient la zone
+        // atteinte, sans copie) ; la zone ne fait que grandir, les mots non nuls des deux
+        // plateaux restent donc entre ces premier et dernier mots
+        change = false;
+        total = 0;
+        for (long i = debut; i <= fin; i++)
+        {
+            if (nouvelles->mots[i] != 0)
+            {
+                nouvelles->mots[i] &= motLibre(partie, (size_t)i);
+                change = change || nouvelles->mots[i] != atteintes->mots[i];
+                total += __builtin_popcountll(nouvelles->mots[i]);
+                aEtoile->debutRempli = (i < aEtoile->debutRempli) ? i : aEtoile->debutRempli;
+                aEtoile->finRempli = (i > aEtoile->finRempli) ? i : aEtoile->finRempli;
+            }
+        }
+        tBitboard echange = aEtoile->atteintes;
+        aEtoile->atteintes = aEtoile->nouvelles;
+        aEtoile->nouvelles = echange;
+    }
+    return total;
 }
+
 /************************************************
-	   FONCTIONS ET PROCEDURES DU SERPENT 2	    
+	   FONCTIONS ET PROCEDURES DES SERPENTS
 *************************************************/
-void dessinerSerpent2(int lesX2[], int lesY2[])
+void placerSerpents(tPartie *partie)
+{
+	// serpent 1 : tête en (X_INITIAL, Y_INITIAL_SERPENT_1), anneaux à sa gauche, vers la DROITE
+	// serpent 2 : tête en (X_INITIAL, Y_INITIAL_SERPENT_2), anneaux à sa droite, vers la GAUCHE
+	// serpents suivants : couchés vers la DROITE, une ligne sur deux, sur les premières
+	// cases libres rencontrées en parcourant le plateau ligne par ligne
+	int numero = 2;
+	coucherSerpent(partie, 0, X_INITIAL, Y_INITIAL_SERPENT_1, DROITE);
+	coucherSerpent(partie, 1, X_INITIAL, Y_INITIAL_SERPENT_2, GAUCHE);
+	for (int y = 3 ; y < hauteurPlateau - 1 && numero < partie->nbSerpents ; y += 2)
+	{
+		int x = 3;
+		while (x + TAILLE < largeurPlateau - 1 && numero < partie->nbSerpents)
+		{
+			// les TAILLE cases du serpent et celle devant sa tête doivent être vides
+			int libres = 0;
+			while (libres <= TAILLE && partie->plateau[CASE(x + libres, y)] == VIDE)
+			{
+				libres++;
+			}
+			if (libres > TAILLE)
+			{
+				coucherSerpent(partie, numero++, x + TAILLE - 1, y, DROITE);
+				x += TAILLE + 2;
+			}
+			else
+			{
+				x += libres + 1;
+			}
+		}
+	}
+	if (numero < partie->nbSerpents)
+	{
+		fprintf(stderr, "Pas assez de place sur le plateau pour %d serpents\n", partie->nbSerpents);
+		exit(EXIT_FAILURE);
+	}
+}
+
+void coucherSerpent(tPartie *partie, int numero, int xTete, int yTete, char direction)
+{
+	// pose un serpent en ligne droite, tête en (xTete, yTete) tournée vers "direction"
+	// (DROITE ou GAUCHE) et anneaux derrière elle, puis l'inscrit sur le plateau
+	tSerpent *serpent = &partie->serpents[numero];
+	int pas = (direction == DROITE) ? -1 : 1;
+	serpent->tete = 0;
+	serpent->longueur = TAILLE;
+	serpent->aGrandir = 0;
+	serpent->direction = direction;
+	for (int i = 0 ; i < TAILLE ; i++)
+	{
+		serpent->lesX[i] = xTete + pas * i;
+		serpent->lesY[i] = yTete;
+		poserAnneau(partie, serpent->lesX[i], serpent->lesY[i]);
+		partie->plateau[CASE(serpent->lesX[i], serpent->lesY[i])] = (i == 0) ? symboleTete(numero) : CORPS;
+	}
+	activerBit(&partie->queues, serpent->lesX[indiceQueue(serpent)], serpent->lesY[indiceQueue(serpent)]);
+}
+
+char symboleTete(int numero)
+{
+	// caractère de la tête d'un serpent, sur le plateau et à l'écran
+	if (numero == 0)
+	{
+		return TETE_SERPENT_1;
+	}
+	return (numero == 1) ? TETE_SERPENT_2 : TETE_AUTRE_SERPENT;
+}
+
+void poserAnneau(tPartie *partie, int x, int y)
+{
+	// un morceau de serpent arrive sur la case (le caractère du plateau est à la charge de l'appelant)
+	if (partie->occupation[CASE(x, y)]++ == 0)
+	{
+		activerBit(&partie->corps, x, y);
+		noterCaseModifiee(partie, x, y);
+	}
+}
+
+void retirerAnneau(tPartie *partie, int x, int y)
+{
+	// un morceau de serpent quitte la case : elle est effacée du plateau
+	// et de l'écran si aucun autre anneau ne l'occupe encore
+	if (--partie->occupation[CASE(x, y)] == 0)
+	{
+		partie->plateau[CASE(x, y)] = VIDE;
+		desactiverBit(&partie->corps, x, y);
+		effacer(partie, x, y);
+		noterCaseModifiee(partie, x, y);
+	}
+}
+
+void noterCaseModifiee(tPartie *partie, int x, int y)
+{
+	// ajoute la case à la liste de celles dont l'occupation a changé à ce tour
+	if (partie->nbCasesModifiees == partie->capaciteCasesModifiees)
+	{
+		partie->capaciteCasesModifiees = (partie->capaciteCasesModifiees == 0) ? 1024 : 2 * partie->capaciteCasesModifiees;
+		partie->casesModifiees = realloc(partie->casesModifiees, partie->capaciteCasesModifiees * sizeof(int));
+		if (partie->casesModifiees == NULL)
+		{
+			perror("realloc");
+			exit(EXIT_FAILURE);
+		}
+	}
+	partie->casesModifiees[partie->nbCasesModifiees++] = CASE(x, y);
+}
+
+void dessinerSerpent(tPartie *partie, int numero)
 {
+	tSerpent *serpent = &partie->serpents[numero];
 	int i;
+	if (!partie->affichage)
+	{
+		return;
+	}
 	// affiche les anneaux puis la tête
-	for(i = 1 ; i < TAILLE ; i++)
+	for(i = 1 ; i < serpent->longueur ; i++)
 	{
-		afficher(lesX2[i], lesY2[i], CORPS);
+		int anneau = (serpent->tete + i) % serpent->capacite;
+		afficher(partie, serpent->lesX[anneau], serpent->lesY[anneau], CORPS);
 	}
-	afficher(lesX2[0], lesY2[0], TETE_SERPENT_2);
+	afficher(partie, serpent->lesX[serpent->tete], serpent->lesY[serpent->tete], symboleTete(numero));
 }
 
-void directionSerpent2(int lesX2[], int lesY2[], tPlateau plateau, char *direction2, int x, int y, int lesX1[], int lesY1[], char directionSerpent1)
+void directionSerpent(tPartie *partie, int numero, int x, int y, tAEtoile *aEtoile)
 {
+    // (aEtoile fournit les plateaux bit à bit du thread appelant, utilisés par mesurerEspace)
+    tSerpent *serpent = &partie->serpents[numero];
     // Calcul des directions possibles
-    int differenceX = x - lesX2[0]; // Différence en X
-    int differenceY = y - lesY2[0]; // Différence en Y
+    int differenceX = x - serpent->lesX[serpent->tete]; // Différence en X
+    int differenceY = y - serpent->lesY[serpent->tete]; // Différence en Y
     
     // Tableau pour stocker les directions possibles sans collision
     char directionsValides[4] = {HAUT, BAS, GAUCHE, DROITE};
@@ -734,343 +5639,892 @@ void directionSerpent2(int lesX2[], int lesY2[], tPlateau plateau, char *directi
     
     // Vérifier chaque direction possible
     for(int i = 0; i < 4; i++) {
-        if(verifierCollisionProchainDeplacement2(lesX2, lesY2, plateau, directionsValides[i], lesX1, lesY1, directionSerpent1)) {
+        if(verifierCollisionProchainDeplacement(partie, numero, directionsValides[i])) {
             directionValide[i] = false;
             nbDirectionsValides--;
         }
     }
+
+    // Écarter les directions qui mènent dans une poche trop petite pour le corps
+    // et d'où la queue est hors d'atteinte, s'il en reste une autre ; sinon garder
+    // seulement celle qui laisse le plus de place
+    int borne = serpent->longueur + serpent->aGrandir;
+    preparerRemplissage(aEtoile);
+    int espaces[4] = {0, 0, 0, 0};
+    bool sure[4] = {false, false, false, false};
+    int nbSures = 0;
+    for(int i = 0; i < 4; i++) {
+        if(directionValide[i]) {
+            int xSuivant, ySuivant;
+            bool queueAtteinte;
+            positionSuivante(serpent->lesX[serpent->tete], serpent->lesY[serpent->tete], directionsValides[i], &xSuivant, &ySuivant);
+            espaces[i] = mesurerEspace(partie, numero, xSuivant, ySuivant, borne, aEtoile, &queueAtteinte);
+            sure[i] = queueAtteinte || espaces[i] >= borne;
+            nbSures += sure[i];
+        }
+    }
+    if(nbSures > 0) {
+        for(int i = 0; i < 4; i++) {
+            if(directionValide[i] && !sure[i]) {
+                directionValide[i] = false;
+                nbDirectionsValides--;
+            }
+        }
+    } else if(nbDirectionsValides > 1) {
+        int meilleure = -1;
+        for(int i = 0; i < 4; i++) {
+            if(directionValide[i] && (meilleure < 0 || espaces[i] > espaces[meilleure])) {
+                meilleure = i;
+            }
+        }
+        for(int i = 0; i < 4; i++) {
+            directionValide[i] = (i == meilleure);
+        }
+        nbDirectionsValides = 1;
+    }
     
     // Si au moins une direction est valide
     if(nbDirectionsValides > 0) {
-        // Priorité à la direction qui rapproche de l'objectif
-        if(abs(differenceX) >= abs(differenceY)) {
-            // Essayer d'abord horizontal
-            if(differenceX > 0 && directionValide[3]) { // DROITE
-                *direction2 = DROITE;
-            } else if(differenceX < 0 && directionValide[2]) { // GAUCHE
-                *direction2 = GAUCHE;
-            }
-            // Si horizontal impossible, essayer vertical
-            else if(differenceY > 0 && directionValide[1]) { // BAS
-                *direction2 = BAS;
-            } else if(differenceY < 0 && directionValide[0]) { // HAUT
-                *direction2 = HAUT;
-            }
-            // Sinon prendre la première direction valide
-            else {
-                for(int i = 0; i < 4; i++) {
-                    if(directionValide[i]) {
-                        *direction2 = directionsValides[i];
-                        break;
-                    }
-                }
-            }
-        } else {
-            // Même quand la différence Y est plus grande, essayer d'abord horizontal
-            if(differenceX > 0 && directionValide[3]) { // DROITE
-                *direction2 = DROITE;
-            } else if(differenceX < 0 && directionValide[2]) { // GAUCHE
-                *direction2 = GAUCHE;
-            }
-            // Si horizontal impossible, essayer vertical
-            else if(differenceY > 0 && directionValide[1]) { // BAS
-                *direction2 = BAS;
-            } else if(differenceY < 0 && directionValide[0]) { // HAUT
-                *direction2 = HAUT;
-            }
-            // Sinon prendre la première direction valide
-            else {
-                for(int i = 0; i < 4; i++) {
-                    if(directionValide[i]) {
-                        *direction2 = directionsValides[i];
-                        break;
-                    }
+        // Priorité à la direction horizontale qui rapproche de l'objectif
+        if(differenceX > 0 && directionValide[3]) { // DROITE
+            serpent->direction = DROITE;
+        } else if(differenceX < 0 && directionValide[2]) { // GAUCHE
+            serpent->direction = GAUCHE;
+        }
+        // Si horizontal impossible, essayer vertical
+        else if(differenceY > 0 && directionValide[1]) { // BAS
+            serpent->direction = BAS;
+        } else if(differenceY < 0 && directionValide[0]) { // HAUT
+            serpent->direction = HAUT;
+        }
+        // Sinon prendre la première direction valide
+        else {
+            for(int i = 0; i < 4; i++) {
+                if(directionValide[i]) {
+                    serpent->direction = directionsValides[i];
+                    break;
                 }
             }
         }
     }
-    // Si aucune direction n'est valide, on garde la direction actuelle
+    // Si aucune direction n'est valide, on garde la direction actuelle
+}
+
+int mesurerEspace(tPartie *partie, int numero, int x, int y, int borne, tAEtoile *aEtoile, bool *queueAtteinte)
+{
+    // remplissage bit à bit des cases libres accessibles depuis (x, y), arrêté dès que
+    // "borne" cases sont atteintes (voir remplirDepuis) ; la queue du serpent est accessible
+    // (il pourra alors la suivre) si l'une de ses voisines a été atteinte.
+    // Retourne le nombre de cases atteintes, au plus borne ;
+    // les plateaux de aEtoile doivent avoir été alloués par preparerRemplissage
+    tSerpent *serpent = &partie->serpents[numero];
+    int queue = indiceQueue(serpent);
+    int xVoisin, yVoisin;
+
+    int espace = remplirDepuis(partie, x, y, borne, aEtoile);
+    *queueAtteinte = false;
+    for (char direction = HAUT; direction <= DROITE && espace > 0; direction++)
+    {
+        positionSuivante(serpent->lesX[queue], serpent->lesY[queue], direction, &xVoisin, &yVoisin);
+        *queueAtteinte = *queueAtteinte || testerBit(&aEtoile->atteintes, xVoisin, yVoisin);
+    }
+    return (espace < borne) ? espace : borne;
+}
+
+bool verifierCollisionProchainDeplacement(tPartie *partie, int numero, char prochaineDirection)
+{
+    tSerpent *serpent = &partie->serpents[numero];
+    int nouvelleX, nouvelleY;
+
+    // Calcul de la nouvelle position (une issue fait passer de l'autre côté du plateau)
+    positionSuivante(serpent->lesX[serpent->tete], serpent->lesY[serpent->tete], prochaineDirection, &nouvelleX, &nouvelleY);
+    int c = CASE(nouvelleX, nouvelleY);
+
+    // Collision avec les bordures et les pavés
+    if (partie->plateau[c] == BORDURE)
+    {
+        return true;
+    }
+
+    // Collision avec le corps (tête comprise) d'un serpent, le sien compris
+    if (partie->occupation[c] > 0)
+    {
+        return true;
+    }
+
+    // Prédiction des prochaines positions des autres serpents : si la tête d'un autre
+    // serpent arrive sur cette case (en gardant sa direction lors du premier choix,
+    // dans la direction qu'il a choisie lors de la résolution des conflits), éviter
+    // (l'annonce du serpent lui-même ne compte pas)
+    if (partie->annonces[c] > ((c == serpent->annonce) ? 1 : 0))
+    {
+        return true;
+    }
+
+    return false;
 }
 
-int calculDistance2(int lesX2[], int lesY2[], int pommeX, int pommeY)
+void progresser(tPartie *partie, int numero)
 {
-    // définition des variables
-    int passageTrouGauche, passageTrouDroit, passageTrouHaut, passageTrouBas, passageDirect;
+    // le corps est rangé dans un tableau circulaire : la nouvelle tête est écrite juste
+    // avant l'ancienne (à la place de la queue quand le tableau est plein), les autres
+    // anneaux ne bougent pas ; en croissance, la queue reste en place et le serpent s'allonge
+    tSerpent *serpent = &partie->serpents[numero];
+    int queue = indiceQueue(serpent);
+    int nouvelleTete = (serpent->tete + serpent->capacite - 1) % serpent->capacite;
+    int xQueue = serpent->lesX[queue];
+    int yQueue = serpent->lesY[queue];
+    int xAncienneTete = serpent->lesX[serpent->tete];
+    int yAncienneTete = serpent->lesY[serpent->tete];
+    int xTete, yTete;
 
-    // Calcul des distances
-    passageTrouGauche = abs(lesX2[0] - ISSUE_GAUCHE_X) + abs(lesY2[0] - ISSUE_GAUCHE_Y) + 
-        abs(pommeX - ISSUE_DROITE_X) + abs(pommeY - ISSUE_DROITE_Y);
-    passageTrouDroit = abs(lesX2[0] - ISSUE_DROITE_X) + abs(lesY2[0] - ISSUE_DROITE_Y) + 
-        abs(pommeX - ISSUE_GAUCHE_X) + abs(pommeY - ISSUE_GAUCHE_Y);
-    passageTrouHaut = abs(lesX2[0] - ISSUE_HAUT_X) + abs(lesY2[0] - ISSUE_HAUT_Y) + 
-        abs(pommeX - ISSUE_BAS_X) + abs(pommeY - ISSUE_BAS_Y);
-    passageTrouBas = abs(lesX2[0] - ISSUE_BAS_X) + abs(lesY2[0] - ISSUE_BAS_Y) + 
-        abs(pommeX - ISSUE_HAUT_X) + abs(pommeY - ISSUE_HAUT_Y);
-    passageDirect = abs(lesX2[0] - pommeX) + abs(lesY2[0] - pommeY);
+    // Faire progresser la tête dans la nouvelle direction
+    // (une issue fait passer de l'autre côté du plateau)
+    positionSuivante(xAncienneTete, yAncienneTete, serpent->direction, &xTete, &yTete);
 
+    serpent->pommeMangee = false;
+    // une bordure ou un pavé arrête le serpent sur place
+    if (partie->plateau[CASE(xTete, yTete)] == BORDURE)
+    {
+        serpent->collision = true;
+        return;
+    }
 
-    // compare les résultats pour obtenir le meilleur chemin
-    // chemin direct vers la pomme sans passer dans un trou
-    if (passageDirect < passageTrouHaut && passageDirect < passageTrouBas &&
-        passageDirect < passageTrouGauche && passageDirect < passageTrouDroit)
+    // Effacer la queue du plateau et de l'écran (sauf si un autre anneau occupe encore la case),
+    // ou la garder si le serpent grandit
+    if (serpent->aGrandir > 0)
     {
-        return CHEMIN_POMME;
+        serpent->aGrandir--;
+        serpent->longueur++;
     }
-    // Privilégie d'abord les passages horizontaux
-    else if (passageTrouGauche <= passageTrouDroit)
+    else
     {
-        return GAUCHE;
+        retirerAnneau(partie, xQueue, yQueue);
+        desactiverBit(&partie->queues, xQueue, yQueue);
     }
-    else if (passageTrouDroit <= passageTrouHaut && passageTrouDroit <= passageTrouBas)
+    serpent->tete = nouvelleTete;
+    serpent->lesX[nouvelleTete] = xTete;
+    serpent->lesY[nouvelleTete] = yTete;
+    // la queue n'est libérée au prochain tour que si le serpent a fini de grandir
+    if (serpent->aGrandir == 0)
     {
-        return DROITE;
+        activerBit(&partie->queues, serpent->lesX[indiceQueue(serpent)], serpent->lesY[indiceQueue(serpent)]);
     }
-    else if (passageTrouHaut <= passageTrouBas)
+
+    // Vérification des collisions et mise à jour du plateau
+    // (sans croissance, comme avant, seul le corps des autres serpents compte : le sien ne provoque
+    // pas de collision ; en croissance, toute case déjà occupée est mortelle ; le corps n'est
+    // parcouru que sans croissance et sur une case occupée, où il faut en séparer ses anneaux)
+    int occupants = partie->occupation[CASE(xTete, yTete)];
+    if (partie->plateau[CASE(xTete, yTete)] == POMME)
     {
-        return HAUT;
+        serpent->pommeMangee = true;
+        partie->plateau[CASE(xTete, yTete)] = VIDE;
     }
-    else
+    else if (occupants > 0 &&
+             (partie->croissance > 0 || occupants > compterAnneaux(serpent, xTete, yTete)))
     {
-        return BAS;
+        serpent->collision = true;
     }
+
+    // Mise à jour du plateau avec les nouvelles positions : l'ancienne tête devient un anneau
+    partie->plateau[CASE(xAncienneTete, yAncienneTete)] = CORPS;
+    partie->plateau[CASE(xTete, yTete)] = symboleTete(numero);
+    poserAnneau(partie, xTete, yTete);
+
+    // Dessiner à l'écran l'ancienne tête et la nouvelle
+    afficher(partie, xAncienneTete, yAncienneTete, CORPS);
+    afficher(partie, xTete, yTete, symboleTete(numero));
 }
 
-bool verifierCollisionProchainDeplacement2(int lesX2[], int lesY2[], tPlateau plateau, char prochaineDirection2, int lesX1[], int lesY1[], char directionSerpent1)
+int compterAnneaux(const tSerpent *serpent, int x, int y)
 {
-    int nouvelleX = lesX2[0];
-    int nouvelleY = lesY2[0];
-
-    // Calcul de la nouvelle position
-    switch (prochaineDirection2)
+    // nombre d'anneaux du serpent, tête exclue, posés sur la case (x, y)
+    int total = 0;
+    for (int i = 1; i < serpent->longueur; i++)
     {
-        case HAUT:
-            nouvelleY--;
-            break;
-        case BAS:
-            nouvelleY++;
-            break;
-        case GAUCHE:
-            nouvelleX--;
-            break;
-        case DROITE:
-            nouvelleX++;
-            break;
+        int anneau = (serpent->tete + i) % serpent->capacite;
+        total += (serpent->lesX[anneau] == x && serpent->lesY[anneau] == y);
     }
+    return total;
+}
 
-    // Prédiction de la prochaine position du serpent 1
-    int prochaineX1 = lesX1[0];
-    int prochaineY1 = lesY1[0];
-    switch (directionSerpent1) {
-        case HAUT:
-            prochaineY1--;
-            break;
-        case BAS:
-            prochaineY1++;
-            break;
-        case GAUCHE:
-            prochaineX1--;
-            break;
-        case DROITE:
-            prochaineX1++;
-            break;
+void retirerSerpent(tPartie *partie, int numero)
+{
+    // retire du plateau et de l'écran le corps d'un serpent éliminé ; les cases encore
+    // occupées par un autre serpent sont redessinées comme un anneau
+    tSerpent *serpent = &partie->serpents[numero];
+    for (int i = 0; i < serpent->longueur; i++)
+    {
+        int anneau = (serpent->tete + i) % serpent->capacite;
+        int x = serpent->lesX[anneau], y = serpent->lesY[anneau];
+        retirerAnneau(partie, x, y);
+        if (partie->occupation[CASE(x, y)] > 0)
+        {
+            partie->plateau[CASE(x, y)] = CORPS;
+            afficher(partie, x, y, CORPS);
+        }
     }
+    desactiverBit(&partie->queues, serpent->lesX[indiceQueue(serpent)], serpent->lesY[indiceQueue(serpent)]);
+    serpent->retire = true;
+}
+
+/************************************************
+			FONCTIONS DU MODE TOURNOI
+*************************************************/
+void genererPartieAleatoire(tPartie *partie, unsigned int graine)
+{
+    // tire une disposition de pavés puis une liste de pommes,
+    // de façon reproductible à partir de la graine
+    int x, y;
+    bool valide;
 
-    // Si la nouvelle position va créer une collision, éviter
-    if (nouvelleX == prochaineX1 && nouvelleY == prochaineY1)
+    for (int i = 0; i < NB_PAVES; i++)
     {
-        return true;
+        // après ESSAIS_PAVE tirages sans succès (plateau où les places valides sont rares),
+        // le pavé prend la première position valide ; main a vérifié qu'il en existe une
+        int essais = 0;
+        do
+        {
+            x = 3 + rand_r(&graine) % (largeurPlateau - taillePaves - 4);
+            y = 3 + rand_r(&graine) % (hauteurPlateau - taillePaves - 4);
+            valide = positionPaveValide(x, y);
+        } while (!valide && ++essais < ESSAIS_PAVE);
+        if (!valide && !premierePositionPave(&x, &y))
+        {
+            fprintf(stderr, "Aucune place pour les pavés sur ce plateau\n");
+            exit(EXIT_FAILURE);
+        }
+        partie->lesPavesX[i] = x;
+        partie->lesPavesY[i] = y;
     }
 
-    // Collision avec les bordures
-    if (plateau[nouvelleX][nouvelleY] == BORDURE)
+    // les pommes sont tirées sur des cases qui ne sont ni une bordure ni un pavé
+    for (int i = 0; i < NB_POMMES; i++)
     {
-        return true;
+        do
+        {
+            x = 2 + rand_r(&graine) % (largeurPlateau - 2);
+            y = 2 + rand_r(&graine) % (hauteurPlateau - 2);
+            valide = true;
+            for (int j = 0; j < NB_PAVES; j++)
+            {
+                if (x >= partie->lesPavesX[j] && x < partie->lesPavesX[j] + taillePaves &&
+                    y >= partie->lesPavesY[j] && y < partie->lesPavesY[j] + taillePaves)
+                {
+                    valide = false;
+                }
+            }
+        } while (!valide);
+        partie->lesPommesX[i] = x;
+        partie->lesPommesY[i] = y;
     }
+}
 
-    // Collision tête contre tête avec le serpent 1
-    if (nouvelleX == lesX1[0] && nouvelleY == lesY1[0])
+bool positionPaveValide(int x, int y)
+{
+    // un pavé tiré au hasard ne doit pas recouvrir la position initiale des serpents
+    // (à une case près), ni boucher le couloir qui mène à une issue
+    if (x <= X_INITIAL + TAILLE && x + taillePaves > X_INITIAL - TAILLE &&
+        ((y <= Y_INITIAL_SERPENT_1 + 1 && y + taillePaves > Y_INITIAL_SERPENT_1 - 1) ||
+         (y <= Y_INITIAL_SERPENT_2 + 1 && y + taillePaves > Y_INITIAL_SERPENT_2 - 1)))
     {
-        return true;
+        return false;
+    }
+    if (x <= xIssues && x + taillePaves > xIssues &&
+        (y <= 3 || y + taillePaves > hauteurPlateau - 3))
+    {
+        return false;
+    }
+    if (y <= yIssues && y + taillePaves > yIssues &&
+        (x <= 3 || x + taillePaves > largeurPlateau - 3))
+    {
+        return false;
     }
+    return true;
+}
 
-    // Collision avec le corps des deux serpents
-    for (int i = 0; i < TAILLE; i++)
+bool premierePositionPave(int *x, int *y)
+{
+    // première position valide (ligne par ligne) parmi celles que genererPartieAleatoire
+    // peut tirer ; retourne false s'il n'y en a aucune
+    for (int yPave = 3; yPave < hauteurPlateau - taillePaves - 1; yPave++)
     {
-        if ((lesX2[i] == nouvelleX && lesY2[i] == nouvelleY) || 
-            (lesX1[i] == nouvelleX && lesY1[i] == nouvelleY))
+        for (int xPave = 3; xPave < largeurPlateau - taillePaves - 1; xPave++)
         {
-            return true;
+            if (positionPaveValide(xPave, yPave))
+            {
+                *x = xPave;
+                *y = yPave;
+                return true;
+            }
         }
     }
-
     return false;
 }
 
-void progresser2(int lesX2[], int lesY2[], char direction2, tPlateau plateau, bool *collision2, bool *pommeMangee2, bool *utiliserIssue2)
+void jouerTournoi(const tPartie *modele, int nbParties, int nbThreads, tBilanTournoi *bilan)
 {
-    // Effacer l'ancienne position du serpent dans le plateau
-    plateau[lesX2[TAILLE - 1]][lesY2[TAILLE - 1]] = VIDE;
-    for (int i = 0; i < TAILLE; i++) {
-        plateau[lesX2[i]][lesY2[i]] = VIDE;
-    }
-    
-    // Effacer le dernier élément à l'écran
-    effacer(lesX2[TAILLE - 1], lesY2[TAILLE - 1]);
+    // chaque thread joue les parties d'indice i tel que i % nbThreads == numéro du thread
+    // sur son propre contexte, puis les bilans sont additionnés
+    pthread_t *threads;
+    tTravailTournoi *travaux;
 
-    // Mettre à jour les positions
-    for (int i = TAILLE - 1; i > 0; i--)
+    if (nbThreads > nbParties)
     {
-        lesX2[i] = lesX2[i - 1];
-        lesY2[i] = lesY2[i - 1];
+        nbThreads = nbParties;
     }
-    
-    // Faire progresser la tête dans la nouvelle direction
-    switch (direction2)
+    threads = malloc(nbThreads * sizeof(pthread_t));
+    travaux = malloc(nbThreads * sizeof(tTravailTournoi));
+    if (threads == NULL || travaux == NULL)
     {
-        case HAUT:
-            lesY2[0] = lesY2[0] - 1;
-            break;
-        case BAS:
-            lesY2[0] = lesY2[0] + 1;
-            break;
-        case DROITE:
-            lesX2[0] = lesX2[0] + 1;
-            break;
-        case GAUCHE:
-            lesX2[0] = lesX2[0] - 1;
-            break;
+        perror("malloc");
+        exit(EXIT_FAILURE);
     }
 
-    // Gestion des passages par les issues
-    if (lesX2[0] <= 0)
-    {
-        lesX2[0] = LARGEUR_PLATEAU;
-        *utiliserIssue2 = true;
-    }
-    else if (lesX2[0] > LARGEUR_PLATEAU)
+    for (int t = 0; t < nbThreads; t++)
     {
-        lesX2[0] = 1;
-        *utiliserIssue2 = true;
+        travaux[t].modele = modele;
+        travaux[t].numero = t;
+        travaux[t].nbThreads = nbThreads;
+        travaux[t].nbParties = nbParties;
+        if (pthread_create(&threads[t], NULL, threadTournoi, &travaux[t]) != 0)
+        {
+            perror("pthread_create");
+            exit(EXIT_FAILURE);
+        }
     }
-    else if (lesY2[0] <= 0)
+
+    // agrégation des bilans des threads
+    memset(bilan, 0, sizeof(*bilan));
+    for (int t = 0; t < nbThreads; t++)
     {
-        lesY2[0] = HAUTEUR_PLATEAU;
-        *utiliserIssue2 = true;
+        pthread_join(threads[t], NULL);
+        bilan->nbParties += travaux[t].bilan.nbParties;
+        bilan->victoires1 += travaux[t].bilan.victoires1;
+        bilan->victoires2 += travaux[t].bilan.victoires2;
+        bilan->egalites += travaux[t].bilan.egalites;
+        bilan->abandons += travaux[t].bilan.abandons;
+        bilan->deplacements1 += travaux[t].bilan.deplacements1;
+        bilan->deplacements2 += travaux[t].bilan.deplacements2;
+        bilan->pommes1 += travaux[t].bilan.pommes1;
+        bilan->pommes2 += travaux[t].bilan.pommes2;
     }
-    else if (lesY2[0] > HAUTEUR_PLATEAU)
+    free(threads);
+    free(travaux);
+}
+
+void *threadTournoi(void *arg)
+{
+    tTravailTournoi *travail = arg;
+    tBilanTournoi *bilan = &travail->bilan;
+    tPartie *partie = malloc(sizeof(tPartie));
+    if (partie == NULL)
     {
-        lesY2[0] = 1;
-        *utiliserIssue2 = true;
+        perror("malloc");
+        exit(EXIT_FAILURE);
     }
 
-    *pommeMangee2 = false;
-    // Vérification des collisions et mise à jour du plateau
-    if (plateau[lesX2[0]][lesY2[0]] == POMME)
+    memset(bilan, 0, sizeof(*bilan));
+    // contexte propre au thread, avec les serpents et les stratégies du modèle
+    initPartie(partie, travail->modele->nbSerpents);
+    partie->nbPlanificateurs = travail->modele->nbPlanificateurs;
+    partie->croissance = travail->modele->croissance;
+    partie->budgetMcts = travail->modele->budgetMcts;
+    // les threads de la stratégie mcts se partagent les coeurs avec les autres parties
+    // du tournoi : chaque partie n'en reçoit qu'une part (au moins le sien)
+    partie->nbThreadsMcts = travail->modele->nbThreadsMcts / travail->nbThreads;
+    if (partie->nbThreadsMcts < 1)
     {
-        *pommeMangee2 = true;
-        plateau[lesX2[0]][lesY2[0]] = VIDE;
+        partie->nbThreadsMcts = 1;
     }
-    else if (plateau[lesX2[0]][lesY2[0]] == BORDURE)
+    partie->budgetAlphaBeta = travail->modele->budgetAlphaBeta;
+    for (int i = 0; i < partie->nbSerpents; i++)
     {
-        *collision2 = true;
+        partie->serpents[i].strategie = travail->modele->serpents[i].strategie;
     }
-    else if (plateau[lesX2[0]][lesY2[0]] == TETE_SERPENT_1 || plateau[lesX2[0]][lesY2[0]] == CORPS)
+    for (int i = travail->numero; i < travail->nbParties; i += travail->nbThreads)
     {
-        *collision2 = true;
+        genererPartieAleatoire(partie, GRAINE_TOURNOI + i);
+        if (jouerPartie(partie) >= LIMITE_DEPLACEMENTS)
+        {
+            bilan->abandons++;
+        }
+        bilan->nbParties++;
+        bilan->victoires1 += (partie->vainqueur == VICTOIRE_SERPENT_1);
+        bilan->victoires2 += (partie->vainqueur == VICTOIRE_SERPENT_2);
+        bilan->egalites += (partie->vainqueur == EGALITE);
+        bilan->victoires2 += (partie->vainqueur > VICTOIRE_SERPENT_2);
+        bilan->deplacements1 += partie->serpents[0].deplacements;
+        bilan->pommes1 += partie->serpents[0].nbPommes;
+        for (int j = 1; j < partie->nbSerpents; j++)
+        {
+            bilan->deplacements2 += partie->serpents[j].deplacements;
+            bilan->pommes2 += partie->serpents[j].nbPommes;
+        }
     }
+    libererPartie(partie);
+    free(partie);
+    return NULL;
+}
 
-    // Mise à jour du plateau avec les nouvelles positions
-    plateau[lesX2[0]][lesY2[0]] = TETE_SERPENT_2;
-    for (int i = 1; i < TAILLE; i++) {
-        plateau[lesX2[i]][lesY2[i]] = CORPS;
-    }
+void afficherBilanTournoi(const tPartie *modele, tBilanTournoi *bilan)
+{
+    int n = (bilan->nbParties > 0) ? bilan->nbParties : 1;
+    // les moyennes des serpents 2 à nbSerpents sont données par serpent
+    int nAutres = n * (modele->nbSerpents - 1);
 
-    // Dessiner le serpent à l'écran
-    dessinerSerpent2(lesX2, lesY2);
+    printf("%d parties jouées (%d égalités, %d abandonnées après %d déplacements)\n",
+        bilan->nbParties, bilan->egalites, bilan->abandons, LIMITE_DEPLACEMENTS);
+    printf("Serpent 1 (%s) : %d victoires (%.1f %%), %.1f déplacements et %.2f pommes par partie\n",
+        NOMS_STRATEGIES[modele->serpents[0].strategie], bilan->victoires1, 100.0 * bilan->victoires1 / n,
+        (double)bilan->deplacements1 / n, (double)bilan->pommes1 / n);
+    printf("%s (%s) : %d victoires (%.1f %%), %.1f déplacements et %.2f pommes par partie\n",
+        (modele->nbSerpents == 2) ? "Serpent 2" : "Serpents 2 et suivants",
+        NOMS_STRATEGIES[modele->serpents[1].strategie], bilan->victoires2, 100.0 * bilan->victoires2 / n,
+        (double)bilan->deplacements2 / nAutres, (double)bilan->pommes2 / nAutres);
 }
 
 /************************************************
-				 FONCTIONS UTILITAIRES 			
+			FONCTIONS DU BANC D'ESSAI
 *************************************************/
-void gotoxy(int x, int y)
-{ 
-    printf("\033[%d;%df", y, x);
+void jouerBancEssai(const tPartie *modele)
+{
+	// mesure le coût des fonctions du moteur sur des états du plateau fixés et reproductibles ;
+	// le nombre d'appels de chaque mesure est doublé jusqu'à durer au moins DUREE_MESURE_BANC
+	printf("Banc d'essai sur un plateau de %d x %d (mesures d'au moins %.1f s)\n",
+		largeurPlateau, hauteurPlateau, DUREE_MESURE_BANC);
+	printf("%-38s %-17s %12s %14s\n", "fonction", "état", "ns/appel", "appels/s");
+	for (int etat = 0; etat < NB_ETATS_BANC; etat++)
+	{
+		tPartie *partie = malloc(sizeof(tPartie));
+		if (partie == NULL)
+		{
+			perror("malloc");
+			exit(EXIT_FAILURE);
+		}
+		initPartie(partie, (etat == ETAT_ENCOMBRE) ? NB_SERPENTS_BANC : NB_SERPENTS);
+		partie->croissance = modele->croissance;
+		memcpy(partie->lesPommesX, modele->lesPommesX, sizeof(partie->lesPommesX));
+		memcpy(partie->lesPommesY, modele->lesPommesY, sizeof(partie->lesPommesY));
+		memcpy(partie->lesPavesX, modele->lesPavesX, sizeof(partie->lesPavesX));
+		memcpy(partie->lesPavesY, modele->lesPavesY, sizeof(partie->lesPavesY));
+		preparerEtatBanc(partie, etat);
+
+		for (int fonction = 0; fonction < NB_FONCTIONS_BANC; fonction++)
+		{
+			// progresser modifie le plateau : il n'est mesuré que sur l'état de départ,
+			// où le serpent 1 tourne en rond sur des cases libres
+			if (fonction == BANC_PROGRESSER && etat != ETAT_DEPART)
+			{
+				continue;
+			}
+			// sans carré libre (pavés tirés au hasard), la mesure ne verrait que des collisions
+			if (fonction == BANC_PROGRESSER && !placerCarreBanc(partie))
+			{
+				printf("%-38s %-17s %27s\n", NOMS_FONCTIONS_BANC[fonction], NOMS_ETATS_BANC[etat],
+					"pas de carré libre");
+				continue;
+			}
+			long nbAppels = 1000;
+			double duree = mesurerFonctionBanc(partie, fonction, nbAppels);
+			while (duree < DUREE_MESURE_BANC)
+			{
+				nbAppels *= 2;
+				duree = mesurerFonctionBanc(partie, fonction, nbAppels);
+			}
+			printf("%-38s %-17s %12.1f %14.0f\n", NOMS_FONCTIONS_BANC[fonction], NOMS_ETATS_BANC[etat],
+				duree * 1e9 / nbAppels, nbAppels / duree);
+		}
+		libererPartie(partie);
+		free(partie);
+	}
+}
+
+void preparerEtatBanc(tPartie *partie, int etat)
+{
+	// départ : partie tout juste mise en place
+	// fin encombrée : NB_SERPENTS_BANC serpents après TOURS_BANC tours de jeu
+	// pavés et issues : serpent 1 à deux cases de l'issue de gauche, serpent 2 la tête
+	// contre le premier pavé, tous deux tournés vers l'obstacle
+	preparerPartie(partie);
+	if (etat == ETAT_ENCOMBRE)
+	{
+		for (int tour = 0; tour < TOURS_BANC && partie->nbVivants >= 2; tour++)
+		{
+			if (jouerTour(partie))
+			{
+				break;
+			}
+		}
+	}
+	else if (etat == ETAT_PAVES_ISSUES)
+	{
+		retirerSerpent(partie, 0);
+		retirerSerpent(partie, 1);
+		coucherSerpent(partie, 0, 3, yIssues, GAUCHE);
+		coucherSerpent(partie, 1, partie->lesPavesX[0] + taillePaves, partie->lesPavesY[0] + taillePaves / 2, GAUCHE);
+		for (int i = 0; i < 2; i++)
+		{
+			partie->serpents[i].retire = false;
+		}
+	}
 }
 
-int kbhit()
+bool placerCarreBanc(tPartie *partie)
 {
-	// la fonction retourne :
-	// 1 si un caractere est present
-	// 0 si pas de caractere présent
-	int unCaractere = 0;
-	struct termios oldt, newt;
-	int ch;
-	int oldf;
+	// couche le serpent 1 vers la DROITE à un endroit où le carré parcouru par la mesure
+	// de progresser et son corps ne rencontrent ni bordure, ni pavé, ni autre serpent :
+	// sa position de départ si elle convient, sinon la première trouvée ligne par ligne ;
+	// retourne false (serpent remis à sa place) s'il n'y en a aucune
+	tSerpent *serpent = &partie->serpents[0];
+	int xDepart = serpent->lesX[serpent->tete];
+	int yDepart = serpent->lesY[serpent->tete];
+	int xTete = xDepart, yTete = yDepart;
+	bool trouve;
 
-	// mettre le terminal en mode non bloquant
-	tcgetattr(STDIN_FILENO, &oldt);
-	newt = oldt;
-	newt.c_lflag &= ~(ICANON | ECHO);
-	tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-	oldf = fcntl(STDIN_FILENO, F_GETFL, 0);
-	fcntl(STDIN_FILENO, F_SETFL, oldf | O_NONBLOCK);
- 
-	ch = getchar();
+	retirerSerpent(partie, 0);
+	trouve = carreLibreBanc(partie, xDepart, yDepart);
+	for (int y = 8 ; !trouve && y < hauteurPlateau ; y++)
+	{
+		for (int x = TAILLE + 1 ; !trouve && x < largeurPlateau - 7 ; x++)
+		{
+			if (carreLibreBanc(partie, x, y))
+			{
+				trouve = true;
+				xTete = x;
+				yTete = y;
+			}
+		}
+	}
+	coucherSerpent(partie, 0, xTete, yTete, DROITE);
+	serpent->retire = false;
+	return trouve;
+}
 
-	// restaurer le mode du terminal
-	tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-	fcntl(STDIN_FILENO, F_SETFL, oldf);
- 
-	if(ch != EOF)
+bool carreLibreBanc(tPartie *partie, int xTete, int yTete)
+{
+	// cases du corps couché vers la DROITE depuis (xTete, yTete) et du tour du carré
+	// de 6 cases de côté (voir mesurerFonctionBanc) toutes libres
+	const char CARRE[4] = {DROITE, HAUT, GAUCHE, BAS};
+	int x = xTete, y = yTete;
+	for (int i = 0 ; i < TAILLE ; i++)
+	{
+		int c = CASE(xTete - i, yTete);
+		if (xTete - i < 1 || partie->plateau[c] == BORDURE || partie->occupation[c] > 0)
+		{
+			return false;
+		}
+	}
+	for (int k = 0 ; k < 24 ; k++)
 	{
-		ungetc(ch, stdin);
-		unCaractere = 1;
-	} 
-	return unCaractere;
+		positionSuivante(x, y, CARRE[k / 6], &x, &y);
+		if (partie->plateau[CASE(x, y)] == BORDURE || partie->occupation[CASE(x, y)] > 0)
+		{
+			return false;
+		}
+	}
+	return true;
 }
 
-// Fonction pour désactiver l'echo
-void disable_echo()
+double mesurerFonctionBanc(tPartie *partie, int fonction, long nbAppels)
 {
-    struct termios tty;
+	// appelle nbAppels fois la fonction, alternativement pour les serpents 1 et 2,
+	// et retourne la durée totale en secondes
+	// (progresser fait faire au serpent 1 le tour d'un carré de 6 cases de côté)
+	const char CARRE[4] = {DROITE, HAUT, GAUCHE, BAS};
+	char directions[2] = {partie->serpents[0].direction, partie->serpents[1].direction};
+	struct timespec debut, fin;
+	volatile int puits = 0; // empêche le compilateur de supprimer les appels sans effet
+	int resultat = 0;
 
-    // Obtenir les attributs du terminal
-    if (tcgetattr(STDIN_FILENO, &tty) == -1) 
+	annoncerDeplacements(partie);
+	if (fonction == BANC_DESSINER_PLATEAU)
 	{
-        perror("tcgetattr");
-        exit(EXIT_FAILURE);
-    }
+		// dessinerPlateau ne remplit l'image de l'écran qu'en mode affichage
+		partie->affichage = true;
+		partie->xVue = 1;
+		partie->yVue = 1;
+		partie->largeurVue = (largeurPlateau < LARGEUR_VUE) ? largeurPlateau : LARGEUR_VUE;
+		partie->hauteurVue = (hauteurPlateau < HAUTEUR_VUE) ? hauteurPlateau : HAUTEUR_VUE;
+	}
+	else if (fonction == BANC_ETAPE_HPA)
+	{
+		// graphe abstrait et route vers la pomme calculés hors de la mesure
+		// (ils ne le sont à la mise en place que si un serpent joue la stratégie heuristique)
+		if (!partie->hpa.calcule)
+		{
+			construireGrapheHpa(partie);
+		}
+		if (!partie->hpa.routeAJour)
+		{
+			calculerRouteHpa(partie);
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &debut);
+	switch (fonction)
+	{
+		case BANC_DIRECTION_SERPENT:
+			for (long k = 0; k < nbAppels; k++)
+			{
+				directionSerpent(partie, k & 1, partie->xPomme, partie->yPomme, &partie->aEtoile);
+			}
+			break;
+		case BANC_VERIFIER_COLLISION:
+			for (long k = 0; k < nbAppels; k++)
+			{
+				resultat += verifierCollisionProchainDeplacement(partie, k & 1, HAUT + ((k >> 1) & 3));
+			}
+			break;
+		case BANC_ETAPE_HPA:
+			for (long k = 0; k < nbAppels; k++)
+			{
+				int xCible, yCible;
+				etapeHpa(partie, k & 1, &partie->aEtoile, &xCible, &yCible);
+				resultat += xCible + yCible;
+			}
+			break;
+		case BANC_PROGRESSER:
+			for (long k = 0; k < nbAppels; k++)
+			{
+				partie->serpents[0].direction = CARRE[(k / 6) % 4];
+				partie->nbCasesModifiees = 0;
+				progresser(partie, 0);
+			}
+			break;
+		case BANC_DESSINER_PLATEAU:
+			for (long k = 0; k < nbAppels; k++)
+			{
+				dessinerPlateau(partie);
+			}
+			break;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &fin);
+	puits = resultat;
+	(void)puits;
+
+	partie->affichage = false;
+	retirerAnnonces(partie);
+	partie->serpents[0].direction = directions[0];
+	partie->serpents[1].direction = directions[1];
+	return (fin.tv_sec - debut.tv_sec) + (fin.tv_nsec - debut.tv_nsec) / 1e9;
+}
 
-    // Désactiver le flag ECHO
-    tty.c_lflag &= ~ECHO;
+/************************************************
+			MESURE DES LATENCES PAR TOUR
+*************************************************/
+long long ecartNs(const struct timespec *debut, const struct timespec *fin)
+{
+	// durée en nanosecondes entre deux instants de l'horloge CLOCK_MONOTONIC
+	return (long long)(fin->tv_sec - debut->tv_sec) * 1000000000LL + (fin->tv_nsec - debut->tv_nsec);
+}
 
-    // Appliquer les nouvelles configurations
-    if (tcsetattr(STDIN_FILENO, TCSANOW, &tty) == -1)
+void enregistrerDuree(tHistogramme *histogramme, long long duree)
+{
+	// ajoute une durée (en nanosecondes) à l'histogramme : un seau par tranche de 1/8
+	// de puissance de 2 au-dessus de 8 ns, calculé sans boucle à partir du bit de poids fort
+	if (duree < 0)
 	{
-        perror("tcsetattr");
-        exit(EXIT_FAILURE);
-    }
+		duree = 0;
+	}
+	unsigned long long v = (unsigned long long)duree;
+	int seau;
+	if (v < SOUS_SEAUX)
+	{
+		seau = (int)v;
+	}
+	else
+	{
+		int puissance = 63 - __builtin_clzll(v);
+		seau = (puissance - 2) * SOUS_SEAUX + (int)((v >> (puissance - 3)) & (SOUS_SEAUX - 1));
+	}
+	histogramme->comptes[seau]++;
+	histogramme->nbMesures++;
+	if (duree > histogramme->maximum)
+	{
+		histogramme->maximum = duree;
+	}
+}
+
+long long quantileHistogramme(const tHistogramme *histogramme, double q)
+{
+	// plus petite borne supérieure de seau sous laquelle se trouve la proportion q des durées
+	// (précision de 12,5 %, jamais au-delà du maximum mesuré)
+	long long rang = (long long)(q * histogramme->nbMesures);
+	long long cumul = 0;
+	if (rang < q * histogramme->nbMesures || rang < 1)
+	{
+		rang++;
+	}
+	for (int seau = 0 ; seau < NB_SEAUX ; seau++)
+	{
+		cumul += histogramme->comptes[seau];
+		if (cumul >= rang)
+		{
+			long long borne;
+			if (seau < SOUS_SEAUX)
+			{
+				borne = seau;
+			}
+			else
+			{
+				int puissance = seau / SOUS_SEAUX + 2;
+				borne = ((long long)(SOUS_SEAUX + seau % SOUS_SEAUX + 1) << (puissance - 3)) - 1;
+			}
+			return (borne < histogramme->maximum) ? borne : histogramme->maximum;
+		}
+	}
+	return histogramme->maximum;
 }
 
-// Fonction pour réactiver l'echo
-void enable_echo()
+void afficherLatences(FILE *sortie, const tPartie *partie)
 {
-    struct termios tty;
+	// p50, p99, p999 et maximum de chaque phase du tour, en microsecondes
+	fprintf(sortie, "Latences par tour (µs)      p50       p99      p999       max    mesures\n");
+	for (int phase = 0 ; phase < NB_PHASES ; phase++)
+	{
+		const tHistogramme *histogramme = &partie->latences[phase];
+		if (histogramme->nbMesures == 0)
+		{
+			continue;
+		}
+		// largeur du nom comptée en caractères : un octet de plus par caractère accentué
+		int largeur = 18;
+		for (const char *c = NOMS_PHASES[phase] ; *c != '\0' ; c++)
+		{
+			largeur += ((*c & 0xC0) == 0x80);
+		}
+		fprintf(sortie, "  %-*s %9.1f %9.1f %9.1f %9.1f %10lld\n", largeur, NOMS_PHASES[phase],
+			quantileHistogramme(histogramme, 0.5) / 1e3, quantileHistogramme(histogramme, 0.99) / 1e3,
+			quantileHistogramme(histogramme, 0.999) / 1e3, histogramme->maximum / 1e3,
+			histogramme->nbMesures);
+	}
+}
 
-    // Obtenir les attributs du terminal
-    if (tcgetattr(STDIN_FILENO, &tty) == -1)
+void ecrireLatences(const char *fichier, const tPartie *partie)
+{
+	// recopie le tableau des latences dans un fichier (écrasé s'il existe)
+	FILE *sortie = fopen(fichier, "w");
+	if (sortie == NULL)
 	{
-        perror("tcgetattr");
-        exit(EXIT_FAILURE);
-    }
+		perror(fichier);
+		return;
+	}
+	afficherLatences(sortie, partie);
+	fclose(sortie);
+}
+
+/************************************************
+				 FONCTIONS UTILITAIRES 			
+*************************************************/
+void gotoxy(int x, int y)
+{ 
+    printf("\033[%d;%df", y, x);
+}
 
-    // Réactiver le flag ECHO
-    tty.c_lflag |= ECHO;
+void activerModeBrut(struct termios *terminalInitial)
+{
+	// passe le terminal, une fois pour toute la partie, en mode brut sans écho :
+	// chaque touche est lisible immédiatement, sans attendre la touche Entrée
+	struct termios tty;
 
-    // Appliquer les nouvelles configurations
-    if (tcsetattr(STDIN_FILENO, TCSANOW, &tty) == -1)
+	if (tcgetattr(STDIN_FILENO, terminalInitial) == -1)
 	{
-        perror("tcsetattr");
-        exit(EXIT_FAILURE);
-    }
+		perror("tcgetattr");
+		exit(EXIT_FAILURE);
+	}
+	tty = *terminalInitial;
+	tty.c_lflag &= ~(ICANON | ECHO);
+	// read rend la main tout de suite, même sans caractère disponible
+	tty.c_cc[VMIN] = 0;
+	tty.c_cc[VTIME] = 0;
+	if (tcsetattr(STDIN_FILENO, TCSANOW, &tty) == -1)
+	{
+		perror("tcsetattr");
+		exit(EXIT_FAILURE);
+	}
+}
+
+char attendreFinTour(tPartie *partie, struct timespec *echeance)
+{
+	// attend l'échéance du tour en cours puis la repousse d'une période : les tours
+	// s'enchaînent à cadence fixe, quelle que soit la durée du calcul de chacun ;
+	// un tour qui dépasse son échéance est compté en retard et la cadence repart de maintenant
+	// (les tours perdus ne sont pas rattrapés en rafale)
+	struct timespec maintenant;
+	char touche;
+
+	clock_gettime(CLOCK_MONOTONIC, &maintenant);
+	if (maintenant.tv_sec > echeance->tv_sec ||
+	    (maintenant.tv_sec == echeance->tv_sec && maintenant.tv_nsec > echeance->tv_nsec))
+	{
+		partie->toursEnRetard++;
+		*echeance = maintenant;
+	}
+	touche = attendreTouche(echeance);
+	avancerEcheance(echeance, partie->periode);
+	return touche;
+}
+
+void avancerEcheance(struct timespec *echeance, long duree)
+{
+	// ajoute "duree" nanosecondes à l'échéance
+	echeance->tv_nsec += duree;
+	echeance->tv_sec += echeance->tv_nsec / 1000000000;
+	echeance->tv_nsec %= 1000000000;
+}
+
+void restaurerTerminal(const struct termios *terminalInitial)
+{
+	// rétablit les réglages du terminal d'avant activerModeBrut
+	if (tcsetattr(STDIN_FILENO, TCSANOW, terminalInitial) == -1)
+	{
+		perror("tcsetattr");
+		exit(EXIT_FAILURE);
+	}
+}
+
+char attendreTouche(const struct timespec *echeance)
+{
+	// attend jusqu'à l'échéance (horloge CLOCK_MONOTONIC) en surveillant le clavier avec poll ;
+	// retourne STOP dès que la touche d'arrêt est frappée, 0 si l'échéance est atteinte
+	// (les autres touches sont lues et ignorées)
+	struct pollfd entree = {STDIN_FILENO, POLLIN, 0};
+	struct timespec maintenant;
+	char ch;
+
+	while (true)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &maintenant);
+		long restant = (echeance->tv_sec - maintenant.tv_sec) * 1000000000L +
+		               (echeance->tv_nsec - maintenant.tv_nsec);
+		if (restant <= 0)
+		{
+			return 0;
+		}
+		if (restant < 1000000)
+		{
+			// moins d'une milliseconde, en dessous de la précision de poll : fin de l'attente
+			// sur l'échéance absolue elle-même, sans dérive
+			while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, echeance, NULL) != 0)
+			{
+			}
+			return 0;
+		}
+		// poll compte en millisecondes : arrondi en dessous, le reste est attendu ci-dessus
+		if (poll(&entree, 1, (int)(restant / 1000000)) > 0)
+		{
+			ssize_t lu = read(STDIN_FILENO, &ch, 1);
+			if (lu == 1 && ch == STOP)
+			{
+				return STOP;
+			}
+			if (lu <= 0 || (entree.revents & (POLLHUP | POLLERR | POLLNVAL)))
+			{
+				// plus rien à lire sur l'entrée : simple attente jusqu'à l'échéance
+				entree.fd = -1;
+			}
+		}
+	}
 }
\ No newline at end of file